@@ -30,12 +30,11 @@ func _ready() -> void:
 		progress_bar.min_value = health.attribute.min_value
 		progress_bar.value = health.get_buffed_value()
 	
-	attribute_container.attribute_changed.connect(func (attribute, _old, new_value):
-		if attribute is HealthAttribute:
-			progress_bar.value = new_value
-			if new_value <= 0.01:
-				is_dead = true
-				died.emit()	
+	attribute_container.subscribe("health", func (_attribute, _old, new_value):
+		progress_bar.value = new_value
+		if new_value <= 0.01:
+			is_dead = true
+			died.emit()	
 	)
 
 
@@ -0,0 +1,79 @@
+extends SceneTree
+# Checks that the values accumulated by a rate attribute reach the listeners at their deadlines and the snapshot on each update.
+# Run with: godot --headless --path godot -s res://tests/test_rate_attribute.gd
+
+var failures := 0
+
+
+func check(condition: bool, message: String) -> void:
+	if not condition:
+		failures += 1
+		printerr("FAILED: " + message)
+
+
+func _initialize() -> void:
+	var health := Attribute.create("health", 10.0, 0.0, 100.0)
+	health.rate_attribute = "health_regen"
+
+	var attribute_set := AttributeSet.new()
+	attribute_set.add_attribute(health)
+	attribute_set.add_attribute(Attribute.create("health_regen", 90.0, 0.0, 1000.0))
+
+	var container := AttributeContainer.new()
+	container.attribute_set = attribute_set
+	root.add_child(container)
+
+	var crossings := []
+	var subscribed_values := []
+	var changes := []
+
+	container.watch("health", 50.0, AttributeContainer.WATCH_RISING)
+	container.threshold_crossed.connect(func(_watch_id, _attribute, _threshold, value): crossings.push_back(value))
+	container.subscribe("health", func(_attribute, _previous_value, new_value): subscribed_values.push_back(new_value), 20.0)
+	container.attribute_changed.connect(func(attribute, _previous_value, _new_value):
+		if attribute.attribute.attribute_name == "health":
+			changes.push_back(attribute)
+	)
+
+	var health_index := -1
+	var attributes = container.get_attributes()
+
+	for i in attributes.size():
+		if attributes[i].attribute.attribute_name == "health":
+			health_index = i
+
+	# half a second of regeneration moves health from 10 to 55, past the watched threshold
+	for i in floori(Engine.physics_ticks_per_second * 0.5) + 2:
+		await physics_frame
+
+	var value: float = container.get_attribute_value_by_name("health")
+
+	check(value > 50.0 and value < 100.0, "health should regenerate, got %s" % value)
+	check(crossings.size() == 1, "the rising watch should fire once, fired %d times" % crossings.size())
+	check(subscribed_values.size() == 2, "the subscription should receive health near 30 and 50, got %s" % [subscribed_values])
+	# the watch at 50 and the second subscription delta fall on the same update or on two close ones
+	check(changes.size() >= 2 and changes.size() <= 3, "health should only be written at the subscription and watch deadlines, written %d times" % changes.size())
+	check(not container.is_sleeping(), "the container should not sleep while a rate moves a value")
+	# the snapshot is published at the end of the previous physics frame, at most one frame of regeneration behind
+	var snapshot_value: float = container.get_value_snapshot(health_index)
+	check(absf(snapshot_value - value) <= 90.0 / Engine.physics_ticks_per_second + 0.01, "the snapshot should follow the rate, got %s instead of %s" % [snapshot_value, value])
+
+	# the clock stops with the container, so does the rate
+	container.process_mode = Node.PROCESS_MODE_DISABLED
+	value = container.get_attribute_value_by_name("health")
+
+	for i in 10:
+		await physics_frame
+
+	check(container.get_attribute_value_by_name("health") == value, "health should not regenerate while the container is disabled")
+	container.process_mode = Node.PROCESS_MODE_INHERIT
+
+	# past the maximum the rate is saturated, the container goes idle again
+	for i in Engine.physics_ticks_per_second:
+		await physics_frame
+
+	check(is_equal_approx(container.get_attribute_value_by_name("health"), 100.0), "health should stop at its maximum")
+	check(container.is_sleeping(), "the container should sleep once the rate is saturated")
+
+	container.queue_free()
+	quit(1 if failures > 0 else 0)
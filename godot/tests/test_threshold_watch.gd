@@ -0,0 +1,52 @@
+extends SceneTree
+# Checks that threshold watches fire on crossings made by any write, including RuntimeAttribute.set_value.
+# Run with: godot --headless --path godot -s res://tests/test_threshold_watch.gd
+
+var failures := 0
+
+
+func check(condition: bool, message: String) -> void:
+	if not condition:
+		failures += 1
+		printerr("FAILED: " + message)
+
+
+func _initialize() -> void:
+	var attribute_set := AttributeSet.new()
+	attribute_set.add_attribute(Attribute.create("health", 100.0, 0.0, 100.0))
+
+	var container := AttributeContainer.new()
+	container.attribute_set = attribute_set
+	root.add_child(container)
+
+	var crossings := []
+	var death_watch: int = container.watch("health", 0.0, AttributeContainer.WATCH_FALLING)
+	var low_health_watch: int = container.watch("health", 25.0, AttributeContainer.WATCH_BOTH)
+
+	container.threshold_crossed.connect(func(watch_id, _attribute, _threshold, value): crossings.push_back([watch_id, value]))
+
+	var health: RuntimeAttribute = container.get_attribute_by_name("health")
+
+	health.set_value(50.0)
+	check(crossings.is_empty(), "no threshold is crossed going from 100 to 50")
+
+	health.set_value(10.0)
+	check(crossings.size() == 1 and crossings[0][0] == low_health_watch, "set_value crossing 25 downwards should fire the low health watch")
+
+	health.set_value(0.0)
+	check(crossings.size() == 2 and crossings[1][0] == death_watch, "set_value reaching 0 should fire the death watch")
+
+	health.set_value(0.0)
+	check(crossings.size() == 2, "setting the same value again should not fire")
+
+	health.set_value(30.0)
+	check(crossings.size() == 3 and crossings[2][0] == low_health_watch, "the both directions watch should fire when rising past 25")
+	check(crossings.size() == 3 and is_equal_approx(crossings[2][1], 30.0), "the crossing should report the new value")
+
+	# deferred writes go through set_value on the next flush
+	container.set_value_deferred("health", 5.0)
+	container.flush_deferred()
+	check(crossings.size() == 4 and crossings[3][0] == low_health_watch, "a deferred set_value should fire the watch once")
+
+	container.queue_free()
+	quit(1 if failures > 0 else 0)
@@ -29,6 +29,11 @@
 
 #include "attribute.hpp"
 #include "attribute_container.hpp"
+#include "attribute_operation_kernels.hpp"
+#include "attribute_recorder.hpp"
+#include "attribute_tags.hpp"
+#include "attribute_tracer.hpp"
+
 
 using namespace gga;
 
@@ -40,6 +45,7 @@ void AttributeOperation::_bind_methods()
 	ClassDB::bind_method(D_METHOD("get_operand"), &AttributeOperation::get_operand);
 	ClassDB::bind_method(D_METHOD("get_value"), &AttributeOperation::get_value);
 	ClassDB::bind_method(D_METHOD("operate", "base_value"), &AttributeOperation::operate);
+	ClassDB::bind_method(D_METHOD("operate_batch", "base_values"), &AttributeOperation::operate_batch);
 	ClassDB::bind_method(D_METHOD("set_operand", "p_value"), &AttributeOperation::set_operand);
 	ClassDB::bind_method(D_METHOD("set_value", "p_value"), &AttributeOperation::set_value);
 
@@ -70,6 +76,11 @@ Ref<AttributeOperation> AttributeOperation::create(const OperationType p_operand
 	return operation;
 }
 
+void AttributeOperation::update_parameter()
+{
+	parameter = OperationKernels::prepare(operand, value);
+}
+
 bool AttributeOperation::operator==(const Ref<AttributeOperation> &buff) const
 {
 	return operand == buff->operand && value == buff->value;
@@ -105,6 +116,11 @@ int AttributeOperation::get_operand() const
 	return (int)operand;
 }
 
+float AttributeOperation::get_parameter() const
+{
+	return parameter;
+}
+
 float AttributeOperation::get_value() const
 {
 	return value;
@@ -112,20 +128,18 @@ float AttributeOperation::get_value() const
 
 float AttributeOperation::operate(float p_base_value) const
 {
-	switch (operand) {
-		case OP_ADD:
-			return p_base_value + value;
-		case OP_DIVIDE:
-			return abs(value) < 0.0001f ? 0 : p_base_value / value;
-		case OP_MULTIPLY:
-			return p_base_value * value;
-		case OP_PERCENTAGE:
-			return p_base_value + ((p_base_value / 100) * value);
-		case OP_SUBTRACT:
-			return p_base_value - value;
-		default:
-			return p_base_value;
+	return OperationKernels::operate(operand, p_base_value, parameter);
+}
+
+PackedFloat32Array AttributeOperation::operate_batch(const PackedFloat32Array &p_base_values) const
+{
+	PackedFloat32Array values = p_base_values;
+
+	if (values.size() > 0) {
+		OperationKernels::operate_batch(operand, values.ptrw(), values.size(), parameter);
 	}
+
+	return values;
 }
 
 void AttributeOperation::set_operand(const int p_value)
@@ -150,11 +164,14 @@ void AttributeOperation::set_operand(const int p_value)
 			operand = OP_ADD;
 			break;
 	}
+
+	update_parameter();
 }
 
 void AttributeOperation::set_value(const float p_value)
 {
 	value = p_value;
+	update_parameter();
 }
 
 #pragma endregion
@@ -169,6 +186,8 @@ void AttributeBuff::_bind_methods()
 	ClassDB::bind_method(D_METHOD("get_duration"), &AttributeBuff::get_duration);
 	ClassDB::bind_method(D_METHOD("get_operation"), &AttributeBuff::get_operation);
 	ClassDB::bind_method(D_METHOD("get_max_applies"), &AttributeBuff::get_max_applies);
+	ClassDB::bind_method(D_METHOD("get_tag_mask"), &AttributeBuff::get_tag_mask);
+	ClassDB::bind_method(D_METHOD("get_tags"), &AttributeBuff::get_tags);
 	ClassDB::bind_method(D_METHOD("get_transient"), &AttributeBuff::get_transient);
 	ClassDB::bind_method(D_METHOD("get_unique"), &AttributeBuff::get_unique);
 	ClassDB::bind_method(D_METHOD("operate", "base_value"), &AttributeBuff::operate);
@@ -177,8 +196,10 @@ void AttributeBuff::_bind_methods()
 	ClassDB::bind_method(D_METHOD("set_duration", "p_value"), &AttributeBuff::set_duration);
 	ClassDB::bind_method(D_METHOD("set_operation", "p_value"), &AttributeBuff::set_operation);
 	ClassDB::bind_method(D_METHOD("set_max_applies", "p_value"), &AttributeBuff::set_max_applies);
+	ClassDB::bind_method(D_METHOD("set_tags", "p_value"), &AttributeBuff::set_tags);
 	ClassDB::bind_method(D_METHOD("set_transient", "p_value"), &AttributeBuff::set_transient);
 	ClassDB::bind_method(D_METHOD("set_unique", "p_value"), &AttributeBuff::set_unique);
+	ClassDB::bind_static_method("AttributeBuff", D_METHOD("tags_to_mask", "p_tags"), &AttributeBuff::tags_to_mask);
 
 	/// binds virtuals to godot
 	GDVIRTUAL_BIND(_applies_to, "attribute_set");
@@ -192,6 +213,7 @@ void AttributeBuff::_bind_methods()
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_applies"), "set_max_applies", "get_max_applies");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "transient"), "set_transient", "get_transient");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "unique"), "set_unique", "get_unique");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "tags"), "set_tags", "get_tags");
 }
 
 bool AttributeBuff::operator==(const Ref<AttributeBuff> &buff) const
@@ -234,6 +256,16 @@ bool AttributeBuff::get_unique() const
 	return unique;
 }
 
+int64_t AttributeBuff::get_tag_mask() const
+{
+	return (int64_t)tag_mask;
+}
+
+PackedStringArray AttributeBuff::get_tags() const
+{
+	return tags;
+}
+
 bool AttributeBuff::is_operate_overridden() const
 {
 	return GDVIRTUAL_IS_OVERRIDDEN_PTR(this, _operate);
@@ -289,6 +321,17 @@ void AttributeBuff::set_unique(const bool p_value)
 	unique = p_value;
 }
 
+void AttributeBuff::set_tags(const PackedStringArray &p_value)
+{
+	tags = p_value;
+	tag_mask = AttributeTags::make_mask(p_value);
+}
+
+int64_t AttributeBuff::tags_to_mask(const PackedStringArray &p_tags)
+{
+	return (int64_t)AttributeTags::make_mask(p_tags);
+}
+
 #pragma endregion
 
 #pragma region AttributeBase
@@ -296,10 +339,20 @@ void AttributeBuff::set_unique(const bool p_value)
 void AttributeBase::_bind_methods()
 {
 	/// binds methods to godot
+	ClassDB::bind_method(D_METHOD("get_aggregation_mode"), &AttributeBase::get_aggregation_mode);
 	ClassDB::bind_method(D_METHOD("get_attribute_name"), &AttributeBase::get_attribute_name);
 	ClassDB::bind_method(D_METHOD("get_buffs"), &AttributeBase::get_buffs);
+	ClassDB::bind_method(D_METHOD("get_max_value_attribute"), &AttributeBase::get_max_value_attribute);
+	ClassDB::bind_method(D_METHOD("get_min_value_attribute"), &AttributeBase::get_min_value_attribute);
+	ClassDB::bind_method(D_METHOD("get_rate_attribute"), &AttributeBase::get_rate_attribute);
+	ClassDB::bind_method(D_METHOD("get_replication_mode"), &AttributeBase::get_replication_mode);
+	ClassDB::bind_method(D_METHOD("set_aggregation_mode", "p_value"), &AttributeBase::set_aggregation_mode);
 	ClassDB::bind_method(D_METHOD("set_attribute_name", "p_value"), &AttributeBase::set_attribute_name);
 	ClassDB::bind_method(D_METHOD("set_buffs", "p_buffs"), &AttributeBase::set_buffs);
+	ClassDB::bind_method(D_METHOD("set_max_value_attribute", "p_value"), &AttributeBase::set_max_value_attribute);
+	ClassDB::bind_method(D_METHOD("set_min_value_attribute", "p_value"), &AttributeBase::set_min_value_attribute);
+	ClassDB::bind_method(D_METHOD("set_rate_attribute", "p_value"), &AttributeBase::set_rate_attribute);
+	ClassDB::bind_method(D_METHOD("set_replication_mode", "p_value"), &AttributeBase::set_replication_mode);
 
 	/// binds virtuals to godot
 	GDVIRTUAL_BIND(_derived_from, "attribute_set");
@@ -309,8 +362,20 @@ void AttributeBase::_bind_methods()
 	GDVIRTUAL_BIND(_get_min_value, "attribute_set");
 
 	/// binds properties to godot
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "aggregation_mode", PROPERTY_HINT_ENUM, "Sequential:0,Categorized:1"), "set_aggregation_mode", "get_aggregation_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "attribute_name"), "set_attribute_name", "get_attribute_name");
 	ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "buffs"), "set_buffs", "get_buffs");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "max_value_attribute"), "set_max_value_attribute", "get_max_value_attribute");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "min_value_attribute"), "set_min_value_attribute", "get_min_value_attribute");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "rate_attribute"), "set_rate_attribute", "get_rate_attribute");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "replication_mode", PROPERTY_HINT_ENUM, "Public:0,Owner Only:1,Server Only:2"), "set_replication_mode", "get_replication_mode");
+
+	/// binds enum as consts
+	BIND_ENUM_CONSTANT(REPLICATION_PUBLIC);
+	BIND_ENUM_CONSTANT(REPLICATION_OWNER_ONLY);
+	BIND_ENUM_CONSTANT(REPLICATION_SERVER_ONLY);
+	BIND_ENUM_CONSTANT(AGGREGATION_SEQUENTIAL);
+	BIND_ENUM_CONSTANT(AGGREGATION_CATEGORIZED);
 }
 
 String AttributeBase::get_attribute_name() const
@@ -322,19 +387,94 @@ String AttributeBase::get_attribute_name() const
 	return attribute_name;
 }
 
+int AttributeBase::get_aggregation_mode() const
+{
+	return (int)aggregation_mode;
+}
+
 TypedArray<AttributeBuff> AttributeBase::get_buffs() const
 {
 	return buffs;
 }
 
+String AttributeBase::get_max_value_attribute() const
+{
+	return max_value_attribute;
+}
+
+String AttributeBase::get_min_value_attribute() const
+{
+	return min_value_attribute;
+}
+
+String AttributeBase::get_rate_attribute() const
+{
+	return rate_attribute;
+}
+
+int AttributeBase::get_replication_mode() const
+{
+	return (int)replication_mode;
+}
+
+float AttributeBase::get_level_scale(const int p_level) const
+{
+	return 1.0f;
+}
+
+bool AttributeBase::has_level_scaling() const
+{
+	return false;
+}
+
+void AttributeBase::set_aggregation_mode(const int p_value)
+{
+	aggregation_mode = p_value == AGGREGATION_CATEGORIZED ? AGGREGATION_CATEGORIZED : AGGREGATION_SEQUENTIAL;
+}
+
 void AttributeBase::set_attribute_name(const String &p_value)
 {
 	attribute_name = p_value;
+	emit_changed();
 }
 
 void AttributeBase::set_buffs(const TypedArray<AttributeBuff> &p_buffs)
 {
 	buffs = p_buffs;
+	emit_changed();
+}
+
+void AttributeBase::set_max_value_attribute(const String &p_value)
+{
+	max_value_attribute = p_value;
+	emit_changed();
+}
+
+void AttributeBase::set_min_value_attribute(const String &p_value)
+{
+	min_value_attribute = p_value;
+	emit_changed();
+}
+
+void AttributeBase::set_rate_attribute(const String &p_value)
+{
+	rate_attribute = p_value;
+	emit_changed();
+}
+
+void AttributeBase::set_replication_mode(const int p_value)
+{
+	switch (p_value) {
+		case REPLICATION_OWNER_ONLY:
+			replication_mode = REPLICATION_OWNER_ONLY;
+			break;
+		case REPLICATION_SERVER_ONLY:
+			replication_mode = REPLICATION_SERVER_ONLY;
+			break;
+		default:
+			replication_mode = REPLICATION_PUBLIC;
+			break;
+	}
 }
 
 #pragma endregion
@@ -347,17 +487,36 @@ void Attribute::_bind_methods()
 	ClassDB::bind_static_method("Attribute", D_METHOD("create", "attribute_name", "initial_value", "min_value", "max_value"), &Attribute::create);
 
 	/// binds methods to godot
+	ClassDB::bind_method(D_METHOD("_on_scaling_curve_changed"), &Attribute::_on_scaling_curve_changed);
+	ClassDB::bind_method(D_METHOD("bake_scaling_table"), &Attribute::bake_scaling_table);
 	ClassDB::bind_method(D_METHOD("get_initial_value"), &Attribute::get_initial_value);
+	ClassDB::bind_method(D_METHOD("get_level_scale", "p_level"), &Attribute::get_level_scale);
+	ClassDB::bind_method(D_METHOD("get_max_level"), &Attribute::get_max_level);
 	ClassDB::bind_method(D_METHOD("get_max_value"), &Attribute::get_max_value);
 	ClassDB::bind_method(D_METHOD("get_min_value"), &Attribute::get_min_value);
+	ClassDB::bind_method(D_METHOD("get_scaling_curve"), &Attribute::get_scaling_curve);
+	ClassDB::bind_method(D_METHOD("get_scaling_table"), &Attribute::get_scaling_table);
+	ClassDB::bind_method(D_METHOD("get_scaling_values"), &Attribute::get_scaling_values);
+	ClassDB::bind_method(D_METHOD("has_level_scaling"), &Attribute::has_level_scaling);
 	ClassDB::bind_method(D_METHOD("set_initial_value", "p_value"), &Attribute::set_initial_value);
+	ClassDB::bind_method(D_METHOD("set_max_level", "p_value"), &Attribute::set_max_level);
 	ClassDB::bind_method(D_METHOD("set_max_value", "p_value"), &Attribute::set_max_value);
 	ClassDB::bind_method(D_METHOD("set_min_value", "p_value"), &Attribute::set_min_value);
+	ClassDB::bind_method(D_METHOD("set_scaling_curve", "p_value"), &Attribute::set_scaling_curve);
+	ClassDB::bind_method(D_METHOD("set_scaling_values", "p_value"), &Attribute::set_scaling_values);
 
 	/// properties to bind to godot
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "initial_value"), "set_initial_value", "get_initial_value");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_value"), "set_max_value", "get_max_value");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "min_value"), "set_min_value", "get_min_value");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "scaling_curve", PROPERTY_HINT_RESOURCE_TYPE, "Curve"), "set_scaling_curve", "get_scaling_curve");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "scaling_values"), "set_scaling_values", "get_scaling_values");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_level", PROPERTY_HINT_RANGE, "1,1000,1,or_greater"), "set_max_level", "get_max_level");
+}
+
+void Attribute::_on_scaling_curve_changed()
+{
+	bake_scaling_table();
 }
 
 Ref<Attribute> Attribute::create(const String &p_attribute_name, const float p_initial_value, const float p_min_value, const float p_max_value)
@@ -388,16 +547,112 @@ float Attribute::get_min_value() const
 void Attribute::set_initial_value(const float p_value)
 {
 	initial_value = p_value;
+	emit_changed();
 }
 
 void Attribute::set_max_value(const float p_value)
 {
 	max_value = p_value;
+	emit_changed();
 }
 
 void Attribute::set_min_value(const float p_value)
 {
 	min_value = p_value;
+	emit_changed();
+}
+
+void Attribute::bake_scaling_table()
+{
+	scaling_table.clear();
+
+	if (scaling_values.size() > 0) {
+		scaling_table.resize(scaling_values.size());
+
+		for (int i = 0; i < scaling_values.size(); i++) {
+			scaling_table[i] = scaling_values[i];
+		}
+	} else if (scaling_curve.is_valid()) {
+		scaling_table.resize(max_level);
+
+		/// the curve is sampled once here, a level lookup never touches the curve again
+		for (int i = 0; i < max_level; i++) {
+			scaling_table[i] = scaling_curve->sample_baked(max_level > 1 ? (float)i / (float)(max_level - 1) : 0.0f);
+		}
+	}
+
+	emit_changed();
+}
+
+float Attribute::get_level_scale(const int p_level) const
+{
+	if (scaling_table.is_empty()) {
+		return 1.0f;
+	}
+
+	uint32_t index = p_level > 1 ? (uint32_t)(p_level - 1) : 0;
+	return scaling_table[index < scaling_table.size() ? index : scaling_table.size() - 1];
+}
+
+bool Attribute::has_level_scaling() const
+{
+	return !scaling_table.is_empty();
+}
+
+int Attribute::get_max_level() const
+{
+	return max_level;
+}
+
+Ref<Curve> Attribute::get_scaling_curve() const
+{
+	return scaling_curve;
+}
+
+PackedFloat32Array Attribute::get_scaling_table() const
+{
+	PackedFloat32Array table;
+	table.resize(scaling_table.size());
+
+	for (uint32_t i = 0; i < scaling_table.size(); i++) {
+		table[i] = scaling_table[i];
+	}
+
+	return table;
+}
+
+PackedFloat32Array Attribute::get_scaling_values() const
+{
+	return scaling_values;
+}
+
+void Attribute::set_max_level(const int p_value)
+{
+	max_level = p_value > 1 ? p_value : 1;
+	bake_scaling_table();
+}
+
+void Attribute::set_scaling_curve(const Ref<Curve> &p_value)
+{
+	Callable on_changed = Callable::create(this, "_on_scaling_curve_changed");
+
+	if (scaling_curve.is_valid() && scaling_curve->is_connected("changed", on_changed)) {
+		scaling_curve->disconnect("changed", on_changed);
+	}
+
+	scaling_curve = p_value;
+
+	if (scaling_curve.is_valid()) {
+		scaling_curve->connect("changed", on_changed);
+	}
+
+	bake_scaling_table();
+}
+
+void Attribute::set_scaling_values(const PackedFloat32Array &p_value)
+{
+	scaling_values = p_value;
+	bake_scaling_table();
 }
 
 #pragma endregion
@@ -407,13 +662,16 @@ void Attribute::set_min_value(const float p_value)
 void AttributeSet::_bind_methods()
 {
 	/// binds methods to godot
+	ClassDB::bind_method(D_METHOD("_on_source_changed"), &AttributeSet::_on_source_changed);
 	ClassDB::bind_method(D_METHOD("add_attribute", "p_attribute"), &AttributeSet::add_attribute);
 	ClassDB::bind_method(D_METHOD("add_attributes", "p_attributes"), &AttributeSet::add_attributes);
+	ClassDB::bind_method(D_METHOD("bake"), &AttributeSet::bake);
 	ClassDB::bind_method(D_METHOD("find_by_classname", "p_classname"), &AttributeSet::find_by_classname);
 	ClassDB::bind_method(D_METHOD("find_by_name", "p_name"), &AttributeSet::find_by_name);
 	ClassDB::bind_method(D_METHOD("get_attributes_names"), &AttributeSet::get_attributes_names);
 	ClassDB::bind_method(D_METHOD("get_attributes"), &AttributeSet::get_attributes);
 	ClassDB::bind_method(D_METHOD("get_set_name"), &AttributeSet::get_set_name);
+	ClassDB::bind_method(D_METHOD("get_template"), &AttributeSet::get_template);
 	ClassDB::bind_method(D_METHOD("has_attribute", "p_attribute"), &AttributeSet::has_attribute);
 	ClassDB::bind_method(D_METHOD("remove_attribute", "p_attribute"), &AttributeSet::remove_attribute);
 	ClassDB::bind_method(D_METHOD("remove_attributes", "p_attributes"), &AttributeSet::remove_attributes);
@@ -429,6 +687,20 @@ void AttributeSet::_bind_methods()
 	ADD_SIGNAL(MethodInfo("attribute_removed", PropertyInfo(Variant::OBJECT, "attribute", PROPERTY_HINT_RESOURCE_TYPE, "AttributeBase")));
 }
 
+void AttributeSet::_on_source_changed()
+{
+	baked_template.unref();
+}
+
+void AttributeSet::disconnect_attribute(const Ref<AttributeBase> &p_attribute)
+{
+	Callable on_changed = Callable::create(this, "_on_source_changed");
+
+	if (p_attribute.is_valid() && p_attribute->is_connected("changed", on_changed)) {
+		p_attribute->disconnect("changed", on_changed);
+	}
+}
+
 bool AttributeSet::operator==(const Ref<AttributeSet> &set) const
 {
 	if (attributes.size() != set->attributes.size()) {
@@ -465,6 +737,7 @@ bool AttributeSet::add_attribute(const Ref<AttributeBase> &p_attribute)
 		Ref<Attribute> d_attribute = p_attribute->duplicate(true);
 
 		attributes.push_back(d_attribute);
+		baked_template.unref();
 		emit_signal("attribute_added", d_attribute);
 		emit_changed();
 		return true;
@@ -490,12 +763,34 @@ uint16_t AttributeSet::add_attributes(const TypedArray<AttributeBase> &p_attribu
 	}
 
 	if (count > 0) {
+		baked_template.unref();
 		emit_changed();
 	}
 
 	return count;
 }
 
+Ref<AttributeSetTemplate> AttributeSet::bake()
+{
+	Callable on_changed = Callable::create(this, "_on_source_changed");
+
+	/// the template is dropped as soon as the set or one of its attributes changes, the next get_template bakes it again
+	if (!is_connected("changed", on_changed)) {
+		connect("changed", on_changed);
+	}
+
+	for (int i = 0; i < attributes.size(); i++) {
+		Ref<AttributeBase> attribute = attributes[i];
+
+		if (attribute.is_valid() && !attribute->is_connected("changed", on_changed)) {
+			attribute->connect("changed", on_changed);
+		}
+	}
+
+	baked_template = AttributeSetTemplate::bake(this);
+	return baked_template;
+}
+
 int AttributeSet::find(const Ref<AttributeBase> &p_attribute) const
 {
 	return attributes.find(p_attribute);
@@ -553,6 +848,15 @@ Ref<AttributeBase> AttributeSet::get_at(int index) const
 	return Ref<Attribute>();
 }
 
+Ref<AttributeSetTemplate> AttributeSet::get_template()
+{
+	if (baked_template.is_null()) {
+		bake();
+	}
+
+	return baked_template;
+}
+
 String AttributeSet::get_set_name() const
 {
 	return set_name;
@@ -575,7 +879,9 @@ bool AttributeSet::remove_attribute(const Ref<AttributeBase> &p_attribute)
 	bool result = false;
 
 	if (index != -1) {
+		disconnect_attribute(p_attribute);
 		attributes.remove_at(index);
+		baked_template.unref();
 		emit_signal("attribute_removed", p_attribute);
 		emit_changed();
 		return true;
@@ -592,6 +898,7 @@ int AttributeSet::remove_attributes(const TypedArray<AttributeBase> &p_attribute
 		int index = attributes.find(p_attributes[i]);
 
 		if (index != -1) {
+			disconnect_attribute(p_attributes[i]);
 			attributes.remove_at(index);
 			count++;
 			emit_signal("attribute_removed", p_attributes[i]);
@@ -599,6 +906,7 @@ int AttributeSet::remove_attributes(const TypedArray<AttributeBase> &p_attribute
 	}
 
 	if (count > 0) {
+		baked_template.unref();
 		emit_changed();
 	}
 
@@ -608,13 +916,19 @@ int AttributeSet::remove_attributes(const TypedArray<AttributeBase> &p_attribute
 void AttributeSet::push_back(const Ref<AttributeBase> &p_attribute)
 {
 	attributes.push_back(p_attribute);
+	baked_template.unref();
 	emit_signal("attribute_added", p_attribute);
 	emit_changed();
 }
 
 void AttributeSet::set_attributes(const TypedArray<AttributeBase> &p_attributes)
 {
+	for (int i = 0; i < attributes.size(); i++) {
+		disconnect_attribute(attributes[i]);
+	}
+
 	attributes = p_attributes;
+	baked_template.unref();
 	emit_changed();
 }
 
@@ -641,6 +955,7 @@ void RuntimeBuff::_bind_methods()
 	ClassDB::bind_method(D_METHOD("get_attribute_name"), &RuntimeBuff::get_attribute_name);
 	ClassDB::bind_method(D_METHOD("get_buff_name"), &RuntimeBuff::get_buff_name);
 	ClassDB::bind_method(D_METHOD("get_duration"), &RuntimeBuff::get_duration);
+	ClassDB::bind_method(D_METHOD("get_handle"), &RuntimeBuff::get_handle);
 	ClassDB::bind_method(D_METHOD("get_time_left"), &RuntimeBuff::get_time_left);
 	ClassDB::bind_method(D_METHOD("set_time_left", "p_value"), &RuntimeBuff::set_time_left);
 	ClassDB::bind_method(D_METHOD("get_buff"), &RuntimeBuff::get_buff);
@@ -658,9 +973,13 @@ bool RuntimeBuff::equals_to(const Ref<AttributeBuff> &p_buff) const
 TypedArray<RuntimeAttribute> RuntimeBuff::applies_to(const AttributeContainer *p_attribute_container) const
 {
 	TypedArray<RuntimeAttribute> attributes = TypedArray<RuntimeAttribute>();
+
+	ERR_FAIL_NULL_V_MSG(p_attribute_container, attributes, "Runtime attribute does not belong to an attribute container.");
+
 	Ref<AttributeSet> attribute_set = p_attribute_container->get_attribute_set();
 
 	if (GDVIRTUAL_IS_OVERRIDDEN_PTR(buff, _applies_to)) {
+		GGA_TRACE_SCOPE("script", "_applies_to", buff->get_buff_name());
 		TypedArray<AttributeBase> _attributes = TypedArray<AttributeBase>();
 
 		if (GDVIRTUAL_CALL_PTR(buff, _applies_to, attribute_set, _attributes)) {
@@ -693,6 +1012,7 @@ TypedArray<float> RuntimeBuff::operate(const TypedArray<RuntimeAttribute> &p_run
 	TypedArray<float> values = TypedArray<float>();
 
 	if (GDVIRTUAL_IS_OVERRIDDEN_PTR(buff, _operate)) {
+		GGA_TRACE_SCOPE("script", "_operate", buff->get_buff_name());
 		TypedArray<AttributeOperation> operations = TypedArray<AttributeOperation>();
 		TypedArray<float> attribute_values = TypedArray<float>();
 
@@ -729,6 +1049,7 @@ Ref<RuntimeBuff> RuntimeBuff::from_buff(const Ref<AttributeBuff> &p_buff)
 	Ref<RuntimeBuff> runtime_buff = memnew(RuntimeBuff);
 	runtime_buff->buff = p_buff;
 	runtime_buff->time_left = p_buff->get_duration();
+	runtime_buff->tag_mask = p_buff->tag_mask;
 	return runtime_buff;
 }
 
@@ -764,7 +1085,7 @@ bool RuntimeBuff::can_apply_to_attribute(const Ref<RuntimeAttribute> &p_attribut
 
 bool RuntimeBuff::can_dequeue() const
 {
-	return Math::is_zero_approx(time_left);
+	return time_left <= 0.0f || Math::is_zero_approx(time_left);
 }
 
 String RuntimeBuff::get_attribute_name() const
@@ -797,9 +1118,15 @@ bool RuntimeBuff::is_operate_overridden() const
 	return GDVIRTUAL_IS_OVERRIDDEN_PTR(buff, _operate);
 }
 
+int64_t RuntimeBuff::get_handle() const
+{
+	return handle;
+}
+
 void RuntimeBuff::set_buff(const Ref<AttributeBuff> &p_value)
 {
 	buff = p_value;
+	tag_mask = p_value.is_valid() ? p_value->tag_mask : 0;
 }
 
 void RuntimeBuff::set_time_left(const float p_value)
@@ -827,8 +1154,10 @@ void RuntimeAttribute::_bind_methods()
 	ClassDB::bind_method(D_METHOD("get_initial_value"), &RuntimeAttribute::get_initial_value);
 	ClassDB::bind_method(D_METHOD("get_max_value"), &RuntimeAttribute::get_max_value);
 	ClassDB::bind_method(D_METHOD("get_value"), &RuntimeAttribute::get_value);
+	ClassDB::bind_method(D_METHOD("invalidate_bounds"), &RuntimeAttribute::invalidate_bounds);
 	ClassDB::bind_method(D_METHOD("remove_buff", "p_buff"), &RuntimeAttribute::remove_buff);
 	ClassDB::bind_method(D_METHOD("remove_buffs", "p_buffs"), &RuntimeAttribute::remove_buffs);
+	ClassDB::bind_method(D_METHOD("remove_buffs_with_tags", "p_tag_mask"), &RuntimeAttribute::remove_buffs_with_tags);
 	ClassDB::bind_method(D_METHOD("set_attribute", "p_value"), &RuntimeAttribute::set_attribute);
 	ClassDB::bind_method(D_METHOD("set_attribute_set", "p_value"), &RuntimeAttribute::set_attribute_set);
 	ClassDB::bind_method(D_METHOD("set_buffs", "p_buffs"), &RuntimeAttribute::set_buffs);
@@ -848,6 +1177,20 @@ void RuntimeAttribute::_bind_methods()
 
 bool RuntimeAttribute::add_buff(const Ref<AttributeBuff> &p_buff)
 {
+	AttributeRecorder *recorder = get_active_recorder();
+
+	if (recorder != nullptr && p_buff.is_valid()) {
+		recorder->record_attribute_buff(AttributeRecorder::EVENT_ADD_ATTRIBUTE_BUFF, attribute_container->recorder_id, attribute->get_attribute_name(), p_buff);
+	}
+
+	Ref<RuntimeBuff> stored;
+	return add_buff_internal(p_buff, stored);
+}
+
+bool RuntimeAttribute::add_buff_internal(const Ref<AttributeBuff> &p_buff, Ref<RuntimeBuff> &r_stored)
+{
+	GGA_TRACE_SCOPE("buff", "add_buff", p_buff.is_valid() ? p_buff->get_buff_name() : String());
+
 	if (!can_receive_buff(p_buff)) {
 		return false;
 	}
@@ -857,11 +1200,15 @@ bool RuntimeAttribute::add_buff(const Ref<AttributeBuff> &p_buff)
 
 	if (p_buff->get_transient()) {
 		buffs.push_back(runtime_buff);
-		emit_signal("buff_added", runtime_buff);
+		r_stored = runtime_buff;
+		notify_buff_added(runtime_buff);
 	} else {
 		TypedArray<RuntimeAttribute> affected_attributes = runtime_buff->applies_to(attribute_container);
-		float max = attribute->get_max_value();
-		float min = attribute->get_min_value();
+		float max = get_max_value();
+		float min = get_min_value();
+
+		settle_rate();
+
 		float prev_value = value;
 
 		ERR_FAIL_COND_V_EDMSG(affected_attributes.size() == 0, false, "Runtime buff does not apply to any attribute.");
@@ -891,7 +1238,7 @@ bool RuntimeAttribute::add_buff(const Ref<AttributeBuff> &p_buff)
 			}
 		}
 
-		emit_signal("attribute_changed", this, prev_value, value);
+		notify_attribute_changed(prev_value, value);
 	}
 
 	return true;
@@ -912,6 +1259,11 @@ int RuntimeAttribute::add_buffs(const TypedArray<AttributeBuff> &p_buffs)
 
 bool RuntimeAttribute::can_receive_buff(const Ref<AttributeBuff> &p_buff) const
 {
+	/// immunities are checked before anything that could call a script
+	if (attribute_container != nullptr && ((uint64_t)p_buff->get_tag_mask() & attribute_container->immunity_mask) != 0) {
+		return false;
+	}
+
 	if (p_buff->get_unique() && has_buff(p_buff)) {
 		return false;
 	}
@@ -948,7 +1300,14 @@ bool RuntimeAttribute::can_receive_buff(const Ref<AttributeBuff> &p_buff) const
 
 void RuntimeAttribute::clear_buffs()
 {
+	if (attribute_container != nullptr) {
+		for (int i = 0; i < buffs.size(); i++) {
+			attribute_container->track_buff(buffs[i], this, -1);
+		}
+	}
+
 	buffs.clear();
+	invalidate_aggregates();
 }
 
 bool RuntimeAttribute::has_buff(const Ref<AttributeBuff> &p_buff) const
@@ -965,13 +1324,24 @@ bool RuntimeAttribute::has_buff(const Ref<AttributeBuff> &p_buff) const
 }
 
 bool RuntimeAttribute::remove_buff(const Ref<AttributeBuff> &p_buff)
+{
+	AttributeRecorder *recorder = get_active_recorder();
+
+	if (recorder != nullptr && p_buff.is_valid()) {
+		recorder->record_attribute_buff(AttributeRecorder::EVENT_REMOVE_ATTRIBUTE_BUFF, attribute_container->recorder_id, attribute->get_attribute_name(), p_buff);
+	}
+
+	return remove_buff_internal(p_buff);
+}
+
+bool RuntimeAttribute::remove_buff_internal(const Ref<AttributeBuff> &p_buff)
 {
 	for (int i = 0; i < buffs.size(); i++) {
 		Ref<RuntimeBuff> buff = buffs[i];
 
 		if (buff->equals_to(p_buff)) {
 			buffs.remove_at(i);
-			emit_signal("buff_removed", buff);
+			notify_buff_removed(buff);
 			return true;
 		}
 	}
@@ -981,26 +1351,78 @@ bool RuntimeAttribute::remove_buff(const Ref<AttributeBuff> &p_buff)
 
 int RuntimeAttribute::remove_buffs(const TypedArray<AttributeBuff> &p_buffs)
 {
+	AttributeRecorder *recorder = get_active_recorder();
 	int count = 0;
 
 	for (int i = p_buffs.size() - 1; i >= 0; i--) {
+		/// each buff is recorded in the order it is processed, removing every stored buff equal to it
+		if (recorder != nullptr && Ref<AttributeBuff>(p_buffs[i]).is_valid()) {
+			recorder->record_attribute_buff(AttributeRecorder::EVENT_REMOVE_ATTRIBUTE_BUFFS, attribute_container->recorder_id, attribute->get_attribute_name(), p_buffs[i]);
+		}
+
 		for (int j = buffs.size() - 1; j >= 0; j--) {
 			Ref<RuntimeBuff> buff = buffs[j];
 
 			if (buff->equals_to(p_buffs[i])) {
 				buffs.remove_at(j);
+				aggregate_buff(buff, -1);
 				count++;
+
+				if (attribute_container != nullptr) {
+					attribute_container->track_buff(buff, this, -1);
+				}
 			}
 		}
 	}
 
-	if (count > 0) {
+	if (count > 0 && has_listeners("buffs_cleared")) {
 		emit_signal("buffs_cleared");
 	}
 
 	return count;
 }
 
+bool RuntimeAttribute::remove_runtime_buff(const Ref<RuntimeBuff> &p_buff)
+{
+	for (int i = buffs.size() - 1; i >= 0; i--) {
+		if (Ref<RuntimeBuff>(buffs[i]) == p_buff) {
+			buffs.remove_at(i);
+			notify_buff_removed(p_buff);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int RuntimeAttribute::remove_buffs_with_tags(const int64_t p_tag_mask)
+{
+	AttributeRecorder *recorder = get_active_recorder();
+
+	if (recorder != nullptr) {
+		recorder->record_remove_tags(attribute_container->recorder_id, attribute->get_attribute_name(), p_tag_mask);
+	}
+
+	return remove_buffs_with_tags_internal(p_tag_mask);
+}
+
+int RuntimeAttribute::remove_buffs_with_tags_internal(const int64_t p_tag_mask)
+{
+	int count = 0;
+
+	for (int i = buffs.size() - 1; i >= 0; i--) {
+		Ref<RuntimeBuff> buff = buffs[i];
+
+		if ((buff->tag_mask & (uint64_t)p_tag_mask) != 0) {
+			buffs.remove_at(i);
+			notify_buff_removed(buff);
+			count++;
+		}
+	}
+
+	return count;
+}
+
 Ref<Attribute> RuntimeAttribute::get_attribute() const
 {
 	return attribute;
@@ -1013,9 +1435,11 @@ Ref<AttributeSet> RuntimeAttribute::get_attribute_set() const
 
 float RuntimeAttribute::get_buffed_value() const
 {
-	float current_value = value;
+	GGA_TRACE_SCOPE("attribute", "get_buffed_value", attribute.is_valid() ? attribute->get_attribute_name() : String());
+	float current_value = read_value();
 
 	if (GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _get_buffed_value)) {
+		GGA_TRACE_SCOPE("script", "_get_buffed_value", attribute->get_attribute_name());
 		TypedArray<AttributeBase> derived_from = get_derived_from();
 		TypedArray<float> values = TypedArray<float>();
 
@@ -1031,13 +1455,48 @@ float RuntimeAttribute::get_buffed_value() const
 		GDVIRTUAL_CALL_PTR(attribute, _get_buffed_value, values, current_value);
 	}
 
+	if (attribute->get_aggregation_mode() == AGGREGATION_CATEGORIZED) {
+		if (aggregates_dirty) {
+			rebuild_aggregates();
+		}
+
+		/// the buff count does not matter, neither does their order
+		return aggregate_zero_multipliers > 0 ? 0.0f : (current_value + aggregate_flat) * (1.0f + aggregate_percentage / 100.0f) * aggregate_multiplier;
+	}
+
+	/// consecutive operations of the same type are dispatched once per run
+	float run[OperationKernels::MAX_RUN];
+	uint32_t run_size = 0;
+	OperationType run_type = OP_ADD;
+
 	for (int i = 0; i < buffs.size(); i++) {
 		Ref<RuntimeBuff> buff = buffs[i];
 		Ref<AttributeBuff> attribute_buff = buff->get_buff();
 
-		if (attribute_buff.is_valid() && !attribute_buff.is_null()) {
+		if (attribute_buff.is_null()) {
+			continue;
+		}
+
+		Ref<AttributeOperation> operation = attribute_buff->get_operation();
+		OperationType type = operation.is_valid() ? (OperationType)operation->get_operand() : run_type;
+
+		if (run_size > 0 && (operation.is_null() || type != run_type || run_size == OperationKernels::MAX_RUN)) {
+			current_value = OperationKernels::operate_run(run_type, current_value, run, run_size);
+			run_size = 0;
+		}
+
+		if (operation.is_null()) {
+			/// reports the missing operation
 			current_value = attribute_buff->operate(current_value);
+			continue;
 		}
+
+		run_type = type;
+		run[run_size++] = operation->get_parameter();
+	}
+
+	if (run_size > 0) {
+		current_value = OperationKernels::operate_run(run_type, current_value, run, run_size);
 	}
 
 	return current_value;
@@ -1045,7 +1504,12 @@ float RuntimeAttribute::get_buffed_value() const
 
 TypedArray<AttributeBase> RuntimeAttribute::get_derived_from() const
 {
+	if (has_derived_from) {
+		return derived_from;
+	}
+
 	if (GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _derived_from)) {
+		GGA_TRACE_SCOPE("script", "_derived_from", attribute->get_attribute_name());
 		TypedArray<AttributeBase> derived_attributes = TypedArray<AttributeBase>();
 
 		if (GDVIRTUAL_CALL_PTR(attribute, _derived_from, attribute_set, derived_attributes)) {
@@ -1056,9 +1520,10 @@ TypedArray<AttributeBase> RuntimeAttribute::get_derived_from() const
 	return TypedArray<AttributeBase>();
 }
 
-float RuntimeAttribute::get_min_value() const
+float RuntimeAttribute::compute_min_value() const
 {
 	if (GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _get_min_value)) {
+		GGA_TRACE_SCOPE("script", "_get_min_value", attribute->get_attribute_name());
 		float ret;
 
 		if (GDVIRTUAL_CALL_PTR(attribute, _get_min_value, attribute_set, ret)) {
@@ -1066,12 +1531,21 @@ float RuntimeAttribute::get_min_value() const
 		}
 	}
 
-	return attribute->get_min_value();
+	if (attribute_container != nullptr && !attribute->get_min_value_attribute().is_empty()) {
+		Ref<RuntimeAttribute> source = attribute_container->get_attribute_by_name(attribute->get_min_value_attribute());
+
+		if (source.is_valid() && source.ptr() != this) {
+			return source->get_buffed_value();
+		}
+	}
+
+	return attribute->get_min_value() * get_level_scale();
 }
 
 float RuntimeAttribute::get_initial_value() const
 {
 	if (GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _get_initial_value)) {
+		GGA_TRACE_SCOPE("script", "_get_initial_value", attribute->get_attribute_name());
 		float ret;
 		TypedArray<AttributeBase> base_attributes = get_derived_from();
 
@@ -1089,12 +1563,13 @@ float RuntimeAttribute::get_initial_value() const
 		}
 	}
 
-	return attribute->get_initial_value();
+	return attribute->get_initial_value() * get_level_scale();
 }
 
-float RuntimeAttribute::get_max_value() const
+float RuntimeAttribute::compute_max_value() const
 {
 	if (GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _get_max_value)) {
+		GGA_TRACE_SCOPE("script", "_get_max_value", attribute->get_attribute_name());
 		float ret;
 
 		if (GDVIRTUAL_CALL_PTR(attribute, _get_max_value, attribute_set, ret)) {
@@ -1102,12 +1577,41 @@ float RuntimeAttribute::get_max_value() const
 		}
 	}
 
-	return attribute->get_max_value();
+	if (attribute_container != nullptr && !attribute->get_max_value_attribute().is_empty()) {
+		Ref<RuntimeAttribute> source = attribute_container->get_attribute_by_name(attribute->get_max_value_attribute());
+
+		if (source.is_valid() && source.ptr() != this) {
+			return source->get_buffed_value();
+		}
+	}
+
+	return attribute->get_max_value() * get_level_scale();
+}
+
+float RuntimeAttribute::get_min_value() const
+{
+	if (bounds_dirty) {
+		/// both bounds are needed by every clamp, they are computed together
+		cached_min_value = compute_min_value();
+		cached_max_value = compute_max_value();
+		bounds_dirty = false;
+	}
+
+	return cached_min_value;
+}
+
+float RuntimeAttribute::get_max_value() const
+{
+	if (bounds_dirty) {
+		get_min_value();
+	}
+
+	return cached_max_value;
 }
 
 float RuntimeAttribute::get_value()
 {
-	return value;
+	return read_value();
 }
 
 TypedArray<RuntimeBuff> RuntimeAttribute::get_buffs() const
@@ -1115,34 +1619,299 @@ TypedArray<RuntimeBuff> RuntimeAttribute::get_buffs() const
 	return buffs;
 }
 
+AttributeRecorder *RuntimeAttribute::get_active_recorder() const
+{
+	if (attribute_container == nullptr || attribute_container->unrecorded) {
+		return nullptr;
+	}
+
+	return attribute_container->recorder;
+}
+
+bool RuntimeAttribute::has_listeners(const StringName &p_signal)
+{
+	if (attribute_container != nullptr) {
+		return attribute_container->has_listeners(this, p_signal);
+	}
+
+	/// a detached attribute has no counter to update, its rare emissions are not worth checking
+	return true;
+}
+
+void RuntimeAttribute::notify_attribute_changed(const float p_previous_value, const float p_new_value)
+{
+	/// the container is wired directly, signals are only for external listeners
+	if (attribute_container != nullptr) {
+		attribute_container->_on_attribute_changed(this, p_previous_value, p_new_value);
+	}
+
+	if (has_listeners("attribute_changed")) {
+		emit_signal("attribute_changed", this, p_previous_value, p_new_value);
+	}
+}
+
+void RuntimeAttribute::notify_buff_added(const Ref<RuntimeBuff> &p_buff)
+{
+	aggregate_buff(p_buff, 1);
+
+	if (attribute_container != nullptr) {
+		attribute_container->_on_buff_applied(this, p_buff);
+	}
+
+	if (has_listeners("buff_added")) {
+		emit_signal("buff_added", p_buff);
+	}
+}
+
+void RuntimeAttribute::notify_buff_removed(const Ref<RuntimeBuff> &p_buff)
+{
+	aggregate_buff(p_buff, -1);
+
+	if (attribute_container != nullptr) {
+		attribute_container->_on_buff_removed(this, p_buff);
+	}
+
+	if (has_listeners("buff_removed")) {
+		emit_signal("buff_removed", p_buff);
+	}
+}
+
+void RuntimeAttribute::add_aggregate(const Ref<RuntimeBuff> &p_buff) const
+{
+	Ref<AttributeBuff> attribute_buff = p_buff->get_buff();
+	Ref<AttributeOperation> operation = attribute_buff.is_valid() ? attribute_buff->get_operation() : Ref<AttributeOperation>();
+
+	p_buff->aggregated = operation.is_valid();
+
+	if (!p_buff->aggregated) {
+		return;
+	}
+
+	p_buff->aggregated_operand = (OperationType)operation->get_operand();
+	/// the divide parameter is the cached reciprocal
+	p_buff->aggregated_value = p_buff->aggregated_operand == OP_MULTIPLY || p_buff->aggregated_operand == OP_DIVIDE ? operation->get_parameter() : operation->get_value();
+
+	apply_aggregate(p_buff->aggregated_operand, p_buff->aggregated_value, 1);
+}
+
+void RuntimeAttribute::aggregate_buff(const Ref<RuntimeBuff> &p_buff, const int32_t p_delta)
+{
+	/// the periodic rebuild bounds the float drift of the repeated updates
+	static constexpr uint32_t REBUILD_INTERVAL = 256;
+
+	if (aggregates_dirty || attribute.is_null() || attribute->get_aggregation_mode() != AGGREGATION_CATEGORIZED || ++aggregate_updates >= REBUILD_INTERVAL) {
+		aggregates_dirty = true;
+		return;
+	}
+
+	if (p_delta > 0) {
+		add_aggregate(p_buff);
+	} else if (p_buff->aggregated) {
+		/// the operation may have been edited since the buff was added, its stored contribution is removed
+		apply_aggregate(p_buff->aggregated_operand, p_buff->aggregated_value, -1);
+		p_buff->aggregated = false;
+	}
+}
+
+void RuntimeAttribute::apply_aggregate(const OperationType p_operand, const float p_value, const int32_t p_sign) const
+{
+	float sign = (float)p_sign;
+
+	switch (p_operand) {
+		case OP_ADD:
+			aggregate_flat += sign * p_value;
+			break;
+		case OP_SUBTRACT:
+			aggregate_flat -= sign * p_value;
+			break;
+		case OP_PERCENTAGE:
+			aggregate_percentage += sign * p_value;
+			break;
+		case OP_MULTIPLY:
+		case OP_DIVIDE:
+			if (p_value == 0.0f) {
+				aggregate_zero_multipliers += p_sign;
+			} else if (p_sign > 0) {
+				aggregate_multiplier *= p_value;
+			} else {
+				aggregate_multiplier /= p_value;
+			}
+			break;
+	}
+}
+
+void RuntimeAttribute::invalidate_aggregates()
+{
+	aggregates_dirty = true;
+}
+
+void RuntimeAttribute::rebuild_aggregates() const
+{
+	aggregate_flat = 0.0f;
+	aggregate_percentage = 0.0f;
+	aggregate_multiplier = 1.0f;
+	aggregate_zero_multipliers = 0;
+	aggregate_updates = 0;
+
+	for (int i = 0; i < buffs.size(); i++) {
+		add_aggregate(buffs[i]);
+	}
+
+	aggregates_dirty = false;
+}
+
+float RuntimeAttribute::get_rated_value(const double p_time) const
+{
+	if (rate == 0.0f || p_time <= rate_time) {
+		return value;
+	}
+
+	float rated_value = value + rate * (float)(p_time - rate_time);
+
+	/// same clamping as set_value, a zero maximum means unbounded
+	if (Math::is_zero_approx(get_max_value())) {
+		return rated_value > get_min_value() ? rated_value : get_min_value();
+	}
+
+	return Math::clamp(rated_value, get_min_value(), get_max_value());
+}
+
+bool RuntimeAttribute::is_rate_moving() const
+{
+	if (rate == 0.0f) {
+		return false;
+	}
+
+	float current_value = read_value();
+
+	if (rate < 0.0f) {
+		return current_value > get_min_value();
+	}
+
+	/// a zero maximum means unbounded, the value never stops growing
+	return Math::is_zero_approx(get_max_value()) || current_value < get_max_value();
+}
+
+void RuntimeAttribute::settle_rate()
+{
+	if (rate == 0.0f || attribute_container == nullptr) {
+		return;
+	}
+
+	value = get_rated_value(attribute_container->clock);
+	rate_time = attribute_container->clock;
+}
+
+void RuntimeAttribute::update_rate()
+{
+	settle_rate();
+
+	rate = 0.0f;
+
+	if (attribute_container != nullptr && !attribute->get_rate_attribute().is_empty()) {
+		Ref<RuntimeAttribute> source = attribute_container->get_attribute_by_name(attribute->get_rate_attribute());
+
+		rate_time = attribute_container->clock;
+
+		if (source.is_valid() && source.ptr() != this) {
+			rate = source->get_buffed_value();
+		}
+
+		attribute_container->rate_deadline_dirty = true;
+
+		/// the clock only advances while the container processes
+		if (rate != 0.0f) {
+			attribute_container->wake_up();
+		}
+	}
+}
+
+float RuntimeAttribute::get_level_scale() const
+{
+	return attribute->get_level_scale(attribute_container != nullptr ? attribute_container->level : 1);
+}
+
+float RuntimeAttribute::read_value() const
+{
+	if (rate != 0.0f) {
+		/// the rate is applied on read, nothing is written while nobody looks at the value
+		return get_rated_value(attribute_container != nullptr ? attribute_container->clock : rate_time);
+	}
+
+	return value;
+}
+
+void RuntimeAttribute::invalidate_bounds()
+{
+	/// the value accumulated so far is clamped to the bounds it accumulated under
+	settle_rate();
+	bounds_dirty = true;
+
+	if (rate != 0.0f) {
+		attribute_container->rate_deadline_dirty = true;
+	}
+}
+
 void RuntimeAttribute::set_attribute(const Ref<AttributeBase> &p_value)
 {
 	attribute = p_value;
+	has_derived_from = false;
+	bounds_dirty = true;
 }
 
 void RuntimeAttribute::set_value(const float p_value)
 {
 	float max_value = get_max_value();
 
+	AttributeRecorder *recorder = get_active_recorder();
+
+	if (recorder != nullptr) {
+		recorder->record_set_value(attribute_container->recorder_id, attribute->get_attribute_name(), p_value);
+	}
+
+	/// every write starts from the value the rate accumulated so far
+	settle_rate();
+
+	float previous_value = value;
+
 	if (Math::is_zero_approx(max_value)) {
 		value = p_value > get_min_value() ? p_value : get_min_value();
 	} else {
 		value = Math::clamp(p_value, get_min_value(), get_max_value());
 	}
+
+	/// the container hooks invalidate the snapshot and the bounds, and evaluate the watches and subscriptions
+	if (value != previous_value) {
+		notify_attribute_changed(previous_value, value);
+	}
 }
 
 void RuntimeAttribute::set_buffs(const TypedArray<AttributeBuff> &p_value)
 {
-	buffs.clear();
+	if (attribute_container != nullptr) {
+		for (int i = 0; i < buffs.size(); i++) {
+			attribute_container->track_buff(buffs[i], this, -1);
+		}
+	}
+
+	buffs = TypedArray<RuntimeBuff>();
+	invalidate_aggregates();
 
 	for (int i = 0; i < p_value.size(); i++) {
-		buffs.push_back(RuntimeBuff::from_buff(p_value[i]));
+		Ref<RuntimeBuff> buff = RuntimeBuff::from_buff(p_value[i]);
+		buffs.push_back(buff);
+
+		if (attribute_container != nullptr) {
+			attribute_container->track_buff(buff, this, 1);
+		}
 	}
 }
 
 void RuntimeAttribute::set_attribute_set(const Ref<AttributeSet> &p_value)
 {
 	attribute_set = p_value;
+	has_derived_from = false;
+	bounds_dirty = true;
 }
 
 #pragma endregion
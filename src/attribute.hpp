@@ -30,6 +30,9 @@
 #ifndef GODOT_GAMEPLAY_ATTRIBUTES_ATTRIBUTE_HPP
 #define GODOT_GAMEPLAY_ATTRIBUTES_ATTRIBUTE_HPP
 
+#include "attribute_set_template.hpp"
+
+#include <godot_cpp/classes/curve.hpp>
 #include <godot_cpp/classes/resource.hpp>
 #include <godot_cpp/core/binder_common.hpp>
 #include <godot_cpp/core/gdvirtual.gen.inc>
@@ -40,6 +43,7 @@ namespace gga
 {
 	class AttributeBase;
 	class AttributeContainer;
+	class AttributeRecorder;
 	class AttributeSet;
 	class RuntimeAttribute;
 
@@ -57,6 +61,24 @@ namespace gga
 		OP_SUBTRACT = 4,
 	};
 
+	enum ReplicationMode
+	{
+		/// @brief The attribute is replicated to every peer.
+		REPLICATION_PUBLIC = 0,
+		/// @brief The attribute is replicated only to the peer owning the container.
+		REPLICATION_OWNER_ONLY = 1,
+		/// @brief The attribute is never replicated.
+		REPLICATION_SERVER_ONLY = 2,
+	};
+
+	enum AggregationMode
+	{
+		/// @brief Buffs are applied one after the other, in the order they were added.
+		AGGREGATION_SEQUENTIAL = 0,
+		/// @brief Buffs are aggregated per category, (base + flat) * (1 + percentage / 100) * multiplier.
+		AGGREGATION_CATEGORIZED = 1,
+	};
+
 	/// @brief Attribute operation.
 	class AttributeOperation : public Resource
 	{
@@ -75,6 +97,11 @@ namespace gga
 		OperationType operand = OperationType::OP_ADD;
 		/// @brief Value.
 		float value = 0.0f;
+		/// @brief The kernel parameter computed from the operand and the value, see GGA_OPERATION_KERNELS.
+		float parameter = 0.0f;
+
+		/// @brief Recomputes the kernel parameter.
+		void update_parameter();
 
 	public:
 		bool operator==(const Ref<AttributeOperation> &buff) const;
@@ -103,12 +130,19 @@ namespace gga
 		/// @brief Get the operand.
 		/// @return The operand.
 		int get_operand() const;
+		/// @brief Get the kernel parameter.
+		/// @return The kernel parameter.
+		float get_parameter() const;
 		/// @brief Get the value.
 		/// @return The value.
 		float get_value() const;
 		/// @brief Operate on a base value.
 		/// @param p_base_value The base value to operate on.
 		float operate(float p_base_value) const;
+		/// @brief Operate on many base values, dispatching once for all of them.
+		/// @param p_base_values The base values to operate on.
+		/// @return The results.
+		PackedFloat32Array operate_batch(const PackedFloat32Array &p_base_values) const;
 		/// @brief Set the operand.
 		void set_operand(const int p_value);
 		/// @brief Set the value.
@@ -124,9 +158,17 @@ namespace gga
 		static void _bind_methods();
 		/// @brief The attributes in the set.
 		TypedArray<AttributeBase> attributes;
+		/// @brief The baked template, built on demand and dropped when the set changes.
+		Ref<AttributeSetTemplate> baked_template;
 		/// @brief The set name.
 		String set_name;
 
+		/// @brief Handles the changed signal of the set and of its attributes, dropping the baked template.
+		void _on_source_changed();
+		/// @brief Stops listening to the changed signal of an attribute leaving the set.
+		/// @param p_attribute The attribute.
+		void disconnect_attribute(const Ref<AttributeBase> &p_attribute);
+
 	public:
 		/// @brief Equal operator overload.
 		/// @param set The AttributeSet to compare.
@@ -148,6 +190,9 @@ namespace gga
 		/// @param p_attributes The attributes to add.
 		/// @return The number of attributes added.
 		uint16_t add_attributes(const TypedArray<AttributeBase> &p_attributes);
+		/// @brief Bakes the set into a template shared by every container using it. The template is dropped when the set or one of its attributes emits changed.
+		/// @return The baked template.
+		Ref<AttributeSetTemplate> bake();
 		/// @brief Finds the index of an attribute in the set.
 		/// @param p_attribute The attribute to find.
 		/// @return The index of the attribute.
@@ -170,6 +215,9 @@ namespace gga
 		/// @param index The index of the attribute.
 		/// @return The attribute.
 		Ref<AttributeBase> get_at(int index) const;
+		/// @brief Get the baked template, baking the set if needed.
+		/// @return The baked template.
+		Ref<AttributeSetTemplate> get_template();
 		/// @brief Get the set name. I dunno if it gets or sets but the pun is intended.
 		/// @return The set name.
 		String get_set_name() const;
@@ -224,11 +272,20 @@ namespace gga
 		bool transient = false;
 		/// @brief If the buff is unique and only one can be applied.
 		bool unique = false;
+		/// @brief The gameplay tags of the buff.
+		PackedStringArray tags;
+		/// @brief The tags interned into a bitmask.
+		uint64_t tag_mask = 0;
 
 	public:
 		// equal operator overload
 		bool operator==(const Ref<AttributeBuff> &buff) const;
 
+		/// @brief Returns the mask of a set of tags.
+		/// @param p_tags The tags.
+		/// @return The tags mask.
+		static int64_t tags_to_mask(const PackedStringArray &p_tags);
+
 		/// @brief Changes which attributes the buff applies to.
 		GDVIRTUAL1RC(TypedArray<AttributeBase>, _applies_to, Ref<AttributeSet>);
 		/// @brief Changes the operation to apply. If overridden, an array of AttributeOperation must be returned. This will skip the operation property.
@@ -253,6 +310,12 @@ namespace gga
 		/// @brief Returns the maximum number of applications possible.
 		/// @return The maximum number of applications possible.
 		int get_max_applies() const;
+		/// @brief Returns the tags interned into a bitmask.
+		/// @return The tags mask.
+		int64_t get_tag_mask() const;
+		/// @brief Returns the gameplay tags of the buff.
+		/// @return The tags.
+		PackedStringArray get_tags() const;
 		/// @brief Returns if the buff is transient.
 		/// @return True if the buff is transient, false otherwise.
 		bool get_transient() const;
@@ -280,6 +343,9 @@ namespace gga
 		/// @brief Sets the maximum number of applications possible.
 		/// @param p_value The maximum number of applications possible.
 		void set_max_applies(const int p_value);
+		/// @brief Sets the gameplay tags of the buff.
+		/// @param p_value The tags.
+		void set_tags(const PackedStringArray &p_value);
 		/// @brief Sets if the buff is transient.
 		/// @param p_value True if the buff is transient, false otherwise.
 		void set_transient(const bool p_value);
@@ -300,6 +366,16 @@ namespace gga
 		String attribute_name;
 		/// @brief The buffs affecting the attribute.
 		TypedArray<AttributeBuff> buffs;
+		/// @brief Which peers the attribute is replicated to.
+		ReplicationMode replication_mode = REPLICATION_PUBLIC;
+		/// @brief How the buffs of the attribute are combined.
+		AggregationMode aggregation_mode = AGGREGATION_SEQUENTIAL;
+		/// @brief The attribute whose buffed value is the maximum value, read when the attribute is added to a container.
+		String max_value_attribute;
+		/// @brief The attribute whose buffed value is the minimum value, read when the attribute is added to a container.
+		String min_value_attribute;
+		/// @brief The attribute whose buffed value is added to the value every second, read when the attribute is added to a container.
+		String rate_attribute;
 
 	public:
 		/// @brief Get the attribute name.
@@ -323,15 +399,52 @@ namespace gga
 		GDVIRTUAL1RC(float, _get_min_value, Ref<AttributeSet>);
 		virtual float get_min_value() const = 0;
 
+		/// @brief Get the aggregation mode.
+		/// @return The aggregation mode.
+		int get_aggregation_mode() const;
 		/// @brief Get the buffs affecting the attribute.
 		/// @return The buffs affecting the attribute.
 		TypedArray<AttributeBuff> get_buffs() const;
+		/// @brief Get the attribute bound to the maximum value.
+		/// @return The attribute name, empty if the maximum value is not bound.
+		String get_max_value_attribute() const;
+		/// @brief Get the attribute bound to the minimum value.
+		/// @return The attribute name, empty if the minimum value is not bound.
+		String get_min_value_attribute() const;
+		/// @brief Get the attribute bound to the rate.
+		/// @return The attribute name, empty if the value has no rate.
+		String get_rate_attribute() const;
+		/// @brief Get the replication mode.
+		/// @return The replication mode.
+		int get_replication_mode() const;
+		/// @brief Get the factor applied to the initial, minimum and maximum values at a level.
+		/// @param p_level The level.
+		/// @return The scaling factor, 1.0 if the attribute does not scale with the level.
+		virtual float get_level_scale(const int p_level) const;
+		/// @brief Check if the attribute values scale with the container level.
+		/// @return True if the attribute has a scaling table.
+		virtual bool has_level_scaling() const;
+		/// @brief Set the aggregation mode.
+		/// @param p_value The aggregation mode.
+		void set_aggregation_mode(const int p_value);
 		/// @brief Set the attribute name.
 		/// @param p_value The attribute name.
 		void set_attribute_name(const String &p_value);
 		/// @brief Set the buffs affecting the attribute.
 		/// @param p_buffs The buffs affecting the attribute.
 		void set_buffs(const TypedArray<AttributeBuff> &p_buffs);
+		/// @brief Bind the maximum value to the buffed value of another attribute of the same container.
+		/// @param p_value The attribute name, empty to unbind.
+		void set_max_value_attribute(const String &p_value);
+		/// @brief Bind the minimum value to the buffed value of another attribute of the same container.
+		/// @param p_value The attribute name, empty to unbind.
+		void set_min_value_attribute(const String &p_value);
+		/// @brief Bind the rate to the buffed value of another attribute of the same container. The value changes by the rate every second, within its bounds.
+		/// @param p_value The attribute name, empty to unbind.
+		void set_rate_attribute(const String &p_value);
+		/// @brief Set the replication mode.
+		/// @param p_value The replication mode.
+		void set_replication_mode(const int p_value);
 	};
 
 	/// @brief Attribute.
@@ -350,6 +463,17 @@ namespace gga
 		float max_value = 0.000000f;
 		/// @brief The minimum value of the attribute.
 		float min_value = 0.000000f;
+		/// @brief The curve sampled to build the scaling table, from level 1 to max_level.
+		Ref<Curve> scaling_curve;
+		/// @brief The explicit scaling factor of each level, starting at level 1. Takes precedence over the curve.
+		PackedFloat32Array scaling_values;
+		/// @brief The number of levels sampled from the scaling curve.
+		int max_level = 100;
+		/// @brief The scaling factors baked from the curve or the explicit values, indexed by level - 1.
+		LocalVector<float> scaling_table;
+
+		/// @brief Handles the changed signal of the scaling curve.
+		void _on_scaling_curve_changed();
 
 	public:
 		/// @brief Create an attribute from some parameters.
@@ -379,6 +503,37 @@ namespace gga
 		/// @brief Set the minimum value of the attribute.
 		/// @param p_value The minimum value of the attribute.
 		void set_min_value(const float p_value);
+
+		/// @brief Bakes the scaling curve or the explicit values into the scaling table. Called whenever one of them changes.
+		void bake_scaling_table();
+		/// @brief Get the factor applied to the initial, minimum and maximum values at a level. Levels past the table use the last factor.
+		/// @param p_level The level.
+		/// @return The scaling factor, 1.0 if the attribute has no scaling table.
+		float get_level_scale(const int p_level) const override;
+		/// @brief Check if the attribute values scale with the container level.
+		/// @return True if the attribute has a scaling table.
+		bool has_level_scaling() const override;
+		/// @brief Get the number of levels sampled from the scaling curve.
+		/// @return The number of levels.
+		int get_max_level() const;
+		/// @brief Get the scaling curve.
+		/// @return The scaling curve.
+		Ref<Curve> get_scaling_curve() const;
+		/// @brief Get the baked scaling table.
+		/// @return The scaling factor of each level, starting at level 1, empty if the attribute does not scale.
+		PackedFloat32Array get_scaling_table() const;
+		/// @brief Get the explicit scaling factors.
+		/// @return The scaling factor of each level, starting at level 1.
+		PackedFloat32Array get_scaling_values() const;
+		/// @brief Set the number of levels sampled from the scaling curve.
+		/// @param p_value The number of levels.
+		void set_max_level(const int p_value);
+		/// @brief Set the scaling curve. The curve is sampled once per level, at (level - 1) / (max_level - 1).
+		/// @param p_value The scaling curve.
+		void set_scaling_curve(const Ref<Curve> &p_value);
+		/// @brief Set the explicit scaling factors.
+		/// @param p_value The scaling factor of each level, starting at level 1.
+		void set_scaling_values(const PackedFloat32Array &p_value);
 	};
 
 	/// @brief Runtime buff. Using class because structs seems to not be allowed in Godot yet.
@@ -387,6 +542,7 @@ namespace gga
 		GDCLASS(RuntimeBuff, RefCounted);
 
 	protected:
+		friend class AttributeContainer;
 		friend class RuntimeAttribute;
 
 		static void _bind_methods();
@@ -396,6 +552,16 @@ namespace gga
 		float time_left = 0.0f;
 		/// @brief If the buff is unique.
 		bool unique = false;
+		/// @brief The tags mask of the buff, cached when the buff is set.
+		uint64_t tag_mask = 0;
+		/// @brief The handle returned by AttributeContainer::apply_buff, 0 if the buff was not applied through a container.
+		int64_t handle = 0;
+		/// @brief The operand the buff contributes to the categorized aggregates with.
+		OperationType aggregated_operand = OP_ADD;
+		/// @brief The value the buff contributes to the categorized aggregates, the parameter for multiply and divide.
+		float aggregated_value = 0.0f;
+		/// @brief True if the contribution is counted in the aggregates of the attribute storing the buff.
+		bool aggregated = false;
 
 		/// @brief Returns the attributes the buff applies to.
 		/// @param p_attribute_set The attribute set to check.
@@ -437,6 +603,9 @@ namespace gga
 		/// @brief Get the buff.
 		/// @return The buff.
 		Ref<AttributeBuff> get_buff() const;
+		/// @brief Get the handle returned by AttributeContainer::apply_buff.
+		/// @return The handle, 0 if the buff was not applied through a container.
+		int64_t get_handle() const;
 		/// @brief Get the duration of the buff.
 		/// @return The duration of the buff.
 		float get_duration() const;
@@ -468,11 +637,112 @@ namespace gga
 		/// @brief The attribute set reference.
 		Ref<AttributeSet> attribute_set;
 		/// @brief The attribute container reference.
-		AttributeContainer *attribute_container;
+		AttributeContainer *attribute_container = nullptr;
 		/// @brief The attribute value.
 		float value = 0.0f;
 		/// @brief The attribute buffs.
 		TypedArray<RuntimeBuff> buffs;
+		/// @brief The attributes this attribute derives from, cached when the attribute comes from a template.
+		TypedArray<AttributeBase> derived_from;
+		/// @brief True if derived_from is cached.
+		bool has_derived_from = false;
+		/// @brief The sum of the flat buffs, used by the categorized aggregation.
+		mutable float aggregate_flat = 0.0f;
+		/// @brief The sum of the percentage buffs, used by the categorized aggregation.
+		mutable float aggregate_percentage = 0.0f;
+		/// @brief The product of the non zero multiplier buffs, used by the categorized aggregation.
+		mutable float aggregate_multiplier = 1.0f;
+		/// @brief The number of zero multiplier buffs, they are counted apart as they can not be divided out.
+		mutable uint32_t aggregate_zero_multipliers = 0;
+		/// @brief The number of incremental updates since the aggregates were computed from the buffs.
+		mutable uint32_t aggregate_updates = 0;
+		/// @brief True if the buffs changed since the aggregates were computed.
+		mutable bool aggregates_dirty = true;
+		/// @brief The cached minimum value.
+		mutable float cached_min_value = 0.0f;
+		/// @brief The cached maximum value.
+		mutable float cached_max_value = 0.0f;
+		/// @brief True if the bounds must be computed again.
+		mutable bool bounds_dirty = true;
+
+		/// @brief Adds or removes the contribution of a buff to the aggregates, without visiting the other buffs.
+		/// @param p_buff The buff.
+		/// @param p_delta 1 if the buff was stored, -1 if it was removed.
+		void aggregate_buff(const Ref<RuntimeBuff> &p_buff, const int32_t p_delta);
+		/// @brief Adds the contribution of a buff to the aggregates, and stores it on the buff so that exactly this contribution is removed later.
+		/// @param p_buff The buff.
+		void add_aggregate(const Ref<RuntimeBuff> &p_buff) const;
+		/// @brief Adds or removes a contribution to the aggregates.
+		/// @param p_operand The operand of the contribution.
+		/// @param p_value The value of the contribution, the parameter for multiply and divide.
+		/// @param p_sign 1 to add the contribution, -1 to remove it.
+		void apply_aggregate(const OperationType p_operand, const float p_value, const int32_t p_sign) const;
+		/// @brief Computes the maximum value, from the script, the bound attribute or the attribute resource.
+		/// @return The maximum value.
+		float compute_max_value() const;
+		/// @brief Computes the minimum value, from the script, the bound attribute or the attribute resource.
+		/// @return The minimum value.
+		float compute_min_value() const;
+		/// @brief Marks the aggregates as outdated.
+		void invalidate_aggregates();
+		/// @brief Computes the aggregates of the categorized aggregation from the buffs.
+		void rebuild_aggregates() const;
+		/// @brief Adds a buff to the attribute.
+		/// @param p_buff The buff to add.
+		/// @param r_stored The runtime buff stored on the attribute, null if the buff modified the value directly.
+		/// @return True if the buff was added, false otherwise.
+		bool add_buff_internal(const Ref<AttributeBuff> &p_buff, Ref<RuntimeBuff> &r_stored);
+		/// @brief Removes a specific runtime buff instance from the attribute.
+		/// @param p_buff The runtime buff.
+		/// @return True if the instance was stored on the attribute.
+		bool remove_runtime_buff(const Ref<RuntimeBuff> &p_buff);
+		/// @brief The rate per second, read from the rate attribute when it changes.
+		float rate = 0.0f;
+		/// @brief The container clock time the stored value was written at, the rate applies from there.
+		double rate_time = 0.0;
+
+		/// @brief Computes the value at a container clock time from the stored value and the rate.
+		/// @param p_time The container clock time.
+		/// @return The value, clamped to the bounds.
+		float get_rated_value(const double p_time) const;
+		/// @brief Returns whether the rate still moves the value, false once the value reached the bound the rate moves toward.
+		/// @return True if the value changes over time.
+		bool is_rate_moving() const;
+		/// @brief Writes the value accumulated by the rate so far, the rate then applies from the current clock time.
+		void settle_rate();
+		/// @brief Settles the value with the previous rate and reads the new rate from the rate attribute.
+		void update_rate();
+		/// @brief Returns the scaling factor of the attribute at the level of the container.
+		/// @return The scaling factor, 1.0 outside of a container.
+		float get_level_scale() const;
+		/// @brief Reads the value from its storage.
+		/// @return The value.
+		float read_value() const;
+		/// @brief Returns the recorder of the container if the calls made on this attribute must be recorded.
+		/// @return The recorder, null if the container is not recorded or is running an operation recorded as a whole.
+		AttributeRecorder *get_active_recorder() const;
+		/// @brief Removes the first stored buff equal to a buff, without recording it.
+		/// @param p_buff The buff.
+		/// @return True if a buff was removed.
+		bool remove_buff_internal(const Ref<AttributeBuff> &p_buff);
+		/// @brief Removes the stored buffs matching a tag mask, without recording it.
+		/// @param p_tag_mask The tag mask.
+		/// @return The number of removed buffs.
+		int remove_buffs_with_tags_internal(const int64_t p_tag_mask);
+		/// @brief Checks if a signal has listeners, counting the skipped emission on the container if it has not.
+		/// @param p_signal The signal name.
+		/// @return True if the signal must be emitted.
+		bool has_listeners(const StringName &p_signal);
+		/// @brief Notifies the container and the listeners that the value changed.
+		/// @param p_previous_value The previous value.
+		/// @param p_new_value The new value.
+		void notify_attribute_changed(const float p_previous_value, const float p_new_value);
+		/// @brief Notifies the container and the listeners that a buff was added.
+		/// @param p_buff The added buff.
+		void notify_buff_added(const Ref<RuntimeBuff> &p_buff);
+		/// @brief Notifies the container and the listeners that a buff was removed.
+		/// @param p_buff The removed buff.
+		void notify_buff_removed(const Ref<RuntimeBuff> &p_buff);
 
 	public:
 		/// @brief Add a buff to the attribute.
@@ -501,6 +771,10 @@ namespace gga
 		/// @param p_buffs The buffs to remove.
 		/// @return The number of buffs removed.
 		int remove_buffs(const TypedArray<AttributeBuff> &p_buffs);
+		/// @brief Removes the buffs having at least one of the given tags.
+		/// @param p_tag_mask The tags mask, see AttributeBuff::tags_to_mask.
+		/// @return The number of buffs removed.
+		int remove_buffs_with_tags(const int64_t p_tag_mask);
 		/// @brief Get the attribute.
 		/// @return The attribute.
 		Ref<Attribute> get_attribute() const;
@@ -527,6 +801,8 @@ namespace gga
 		float get_value();
 		/// @brief Get the buffs affecting the attribute.
 		TypedArray<RuntimeBuff> get_buffs() const;
+		/// @brief Marks the cached minimum and maximum values as outdated, they are computed again on the next read.
+		void invalidate_bounds();
 		/// @brief Set the attribute.
 		/// @param p_value The attribute.
 		void set_attribute(const Ref<AttributeBase> &p_value);
@@ -542,6 +818,8 @@ namespace gga
 	};
 } //namespace gga
 
+VARIANT_ENUM_CAST(gga::AggregationMode);
 VARIANT_ENUM_CAST(gga::OperationType);
+VARIANT_ENUM_CAST(gga::ReplicationMode);
 
 #endif
@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*  attribute_command_queue.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "attribute_command_queue.hpp"
+
+#include "attribute.hpp"
+
+#include <godot_cpp/core/memory.hpp>
+
+using namespace gga;
+
+AttributeCommandQueue::AttributeCommandQueue()
+{
+	stub.next.store(nullptr, std::memory_order_relaxed);
+	head.store(&stub, std::memory_order_relaxed);
+	tail = &stub;
+}
+
+AttributeCommandQueue::~AttributeCommandQueue()
+{
+	Command command;
+
+	while (pop(command)) {
+	}
+}
+
+void AttributeCommandQueue::push_node(Node *p_node)
+{
+	p_node->next.store(nullptr, std::memory_order_relaxed);
+	Node *previous = head.exchange(p_node, std::memory_order_seq_cst);
+	/// between the exchange and this store the queue is briefly unlinked, the consumer sees it as empty
+	previous->next.store(p_node, std::memory_order_release);
+}
+
+void AttributeCommandQueue::push(const Command &p_command)
+{
+	Node *node = memnew(Node);
+	node->command = p_command;
+	push_node(node);
+}
+
+bool AttributeCommandQueue::is_empty() const
+{
+	/// a push in progress has already moved the head, it is seen as a queued command
+	return tail == &stub && head.load(std::memory_order_seq_cst) == &stub;
+}
+
+bool AttributeCommandQueue::pop(Command &r_command)
+{
+	Node *node = tail;
+	Node *next = node->next.load(std::memory_order_acquire);
+
+	if (node == &stub) {
+		if (next == nullptr) {
+			return false;
+		}
+
+		tail = next;
+		node = next;
+		next = next->next.load(std::memory_order_acquire);
+	}
+
+	if (next == nullptr) {
+		if (node != head.load(std::memory_order_acquire)) {
+			/// a producer is linking a node after this one
+			return false;
+		}
+
+		/// the stub is pushed back so the last node can be released
+		push_node(&stub);
+		next = node->next.load(std::memory_order_acquire);
+
+		if (next == nullptr) {
+			return false;
+		}
+	}
+
+	tail = next;
+	r_command = node->command;
+	memdelete(node);
+
+	return true;
+}
@@ -0,0 +1,113 @@
+/**************************************************************************/
+/*  attribute_command_queue.hpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GGA_ATTRIBUTE_COMMAND_QUEUE_HPP
+#define GGA_ATTRIBUTE_COMMAND_QUEUE_HPP
+
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+using namespace godot;
+
+namespace gga
+{
+	class AttributeBuff;
+
+	/// @brief Lock-free multiple producers, single consumer queue of deferred AttributeContainer commands.
+	///
+	/// Any thread can push commands without blocking, only the thread owning the container pops them.
+	/// Commands are popped in the order their push completed. A command whose push is still in progress
+	/// stops the drain, it is popped by the next drain together with the ones pushed after it.
+	class AttributeCommandQueue
+	{
+	public:
+		/// @brief The kind of command.
+		enum CommandType : uint8_t
+		{
+			COMMAND_APPLY_BUFF,
+			COMMAND_REMOVE_BUFF,
+			COMMAND_SET_VALUE,
+		};
+
+		/// @brief A deferred command.
+		struct Command
+		{
+			/// @brief The kind of command.
+			CommandType type = COMMAND_APPLY_BUFF;
+			/// @brief The buff to apply or remove.
+			Ref<AttributeBuff> buff;
+			/// @brief The name of the attribute to set.
+			String attribute_name;
+			/// @brief The value to set.
+			float value = 0.0f;
+		};
+
+	private:
+		/// @brief Queue node, the command lives in the node itself.
+		struct Node
+		{
+			std::atomic<Node *> next;
+			Command command;
+		};
+
+		/// @brief The last pushed node, shared by the producers.
+		std::atomic<Node *> head;
+		/// @brief The next node to pop, owned by the consumer.
+		Node *tail = nullptr;
+		/// @brief Placeholder node keeping the queue non empty.
+		Node stub;
+
+		/// @brief Links a node at the end of the queue.
+		/// @param p_node The node to link.
+		void push_node(Node *p_node);
+
+	public:
+		AttributeCommandQueue();
+		~AttributeCommandQueue();
+
+		AttributeCommandQueue(const AttributeCommandQueue &) = delete;
+		AttributeCommandQueue &operator=(const AttributeCommandQueue &) = delete;
+
+		/// @brief Pushes a command. Safe to call from any thread.
+		/// @param p_command The command to push.
+		void push(const Command &p_command);
+		/// @brief Returns if no command is queued or being queued. Must be called from the consumer thread only.
+		/// @return True if the queue is empty.
+		bool is_empty() const;
+		/// @brief Pops the oldest command. Must be called from the consumer thread only.
+		/// @param r_command The popped command.
+		/// @return True if a command was popped, false if the queue is empty or the next push is not complete yet.
+		bool pop(Command &r_command);
+	};
+} //namespace gga
+
+#endif
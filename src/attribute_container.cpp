@@ -30,21 +30,60 @@
 #include "attribute_container.hpp"
 
 #include "attribute.hpp"
+#include "attribute_recorder.hpp"
+#include "attribute_set_template.hpp"
+#include "attribute_tracer.hpp"
 #include "buff_pool_queue.hpp"
 
+#include <godot_cpp/core/defs.hpp>
+#include <godot_cpp/core/object.hpp>
+
+#include <type_traits>
+#include <utility>
+
 using namespace gga;
 
+namespace
+{
+	/// @brief Detects whether the godot-cpp binding exposes Object::has_connections, older extension APIs do not.
+	template <typename T, typename = void>
+	struct HasConnectionsBinding : std::false_type
+	{
+	};
+
+	template <typename T>
+	struct HasConnectionsBinding<T, std::void_t<decltype(std::declval<const T &>().has_connections(std::declval<const StringName &>()))>> : std::true_type
+	{
+	};
+
+	/// @brief Returns whether a signal may have listeners, true if the binding can not tell cheaply.
+	template <typename T>
+	bool may_have_connections(const T *p_emitter, const StringName &p_signal)
+	{
+		if constexpr (HasConnectionsBinding<T>::value) {
+			return p_emitter->has_connections(p_signal);
+		} else {
+			/// the connection list is the only alternative, building it costs more than the emission it would skip
+			return true;
+		}
+	}
+} //namespace
+
 void AttributeContainer::_bind_methods()
 {
 	/// binds methods to godot
-	ClassDB::bind_method(D_METHOD("_on_attribute_changed", "p_attribute", "p_previous_value", "p_new_value"), &AttributeContainer::_on_attribute_changed);
-	ClassDB::bind_method(D_METHOD("_on_buff_applied", "p_buff"), &AttributeContainer::_on_buff_applied);
 	ClassDB::bind_method(D_METHOD("_on_buff_dequeued", "p_buff"), &AttributeContainer::_on_buff_dequeued);
 	ClassDB::bind_method(D_METHOD("_on_buff_enqueued", "p_buff"), &AttributeContainer::_on_buff_enqueued);
-	ClassDB::bind_method(D_METHOD("_on_buff_removed", "p_buff"), &AttributeContainer::_on_buff_removed);
+	ClassDB::bind_method(D_METHOD("_on_screen_entered"), &AttributeContainer::_on_screen_entered);
+	ClassDB::bind_method(D_METHOD("_on_screen_exited"), &AttributeContainer::_on_screen_exited);
+	ClassDB::bind_method(D_METHOD("acknowledge_delta", "p_sequence", "p_peer"), &AttributeContainer::acknowledge_delta, DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("add_attribute", "p_attribute"), &AttributeContainer::add_attribute);
 	ClassDB::bind_method(D_METHOD("apply_buff", "p_buff"), &AttributeContainer::apply_buff);
+	ClassDB::bind_method(D_METHOD("apply_buff_deferred", "p_buff"), &AttributeContainer::apply_buff_deferred);
+	ClassDB::bind_method(D_METHOD("apply_delta", "p_packet"), &AttributeContainer::apply_delta);
+	ClassDB::bind_method(D_METHOD("encode_delta", "p_full", "p_peer"), &AttributeContainer::encode_delta, DEFVAL(false), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("find", "p_predicate"), &AttributeContainer::find);
+	ClassDB::bind_method(D_METHOD("flush_deferred"), &AttributeContainer::flush_deferred);
 	ClassDB::bind_method(D_METHOD("find_buffed_value", "p_predicate"), &AttributeContainer::find_buffed_value);
 	ClassDB::bind_method(D_METHOD("find_value", "p_predicate"), &AttributeContainer::find_value);
 	ClassDB::bind_method(D_METHOD("get_attribute_set"), &AttributeContainer::get_attribute_set);
@@ -52,16 +91,69 @@ void AttributeContainer::_bind_methods()
 	ClassDB::bind_method(D_METHOD("get_attribute_by_name", "p_name"), &AttributeContainer::get_attribute_by_name);
 	ClassDB::bind_method(D_METHOD("get_attribute_buffed_value_by_name", "p_name"), &AttributeContainer::get_attribute_buffed_value_by_name);
 	ClassDB::bind_method(D_METHOD("get_attribute_value_by_name", "p_name"), &AttributeContainer::get_attribute_value_by_name);
+	ClassDB::bind_method(D_METHOD("get_buffed_value_snapshot", "p_index"), &AttributeContainer::get_buffed_value_snapshot);
+	ClassDB::bind_method(D_METHOD("get_dirty_mask", "p_peer"), &AttributeContainer::get_dirty_mask, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("get_immunity_tags"), &AttributeContainer::get_immunity_tags);
+	ClassDB::bind_method(D_METHOD("get_level"), &AttributeContainer::get_level);
+	ClassDB::bind_method(D_METHOD("get_offscreen_update_tier"), &AttributeContainer::get_offscreen_update_tier);
+	ClassDB::bind_method(D_METHOD("get_owner_peer"), &AttributeContainer::get_owner_peer);
+	ClassDB::bind_method(D_METHOD("get_public_visibility"), &AttributeContainer::get_public_visibility);
+	ClassDB::bind_method(D_METHOD("get_replication_precision"), &AttributeContainer::get_replication_precision);
 	ClassDB::bind_method(D_METHOD("get_server_authoritative"), &AttributeContainer::get_server_authoritative);
+	ClassDB::bind_method(D_METHOD("get_skipped_signal_count"), &AttributeContainer::get_skipped_signal_count);
+	ClassDB::bind_method(D_METHOD("get_snapshot_size"), &AttributeContainer::get_snapshot_size);
+	ClassDB::bind_method(D_METHOD("get_tag_count", "p_tag"), &AttributeContainer::get_tag_count);
+	ClassDB::bind_method(D_METHOD("get_update_tier"), &AttributeContainer::get_update_tier);
+	ClassDB::bind_method(D_METHOD("get_value_snapshot", "p_index"), &AttributeContainer::get_value_snapshot);
+	ClassDB::bind_method(D_METHOD("get_visibility_for", "p_peer"), &AttributeContainer::get_visibility_for);
+	ClassDB::bind_method(D_METHOD("get_visibility_notifier"), &AttributeContainer::get_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("has_buff_with_tags", "p_tag_mask"), &AttributeContainer::has_buff_with_tags);
+	ClassDB::bind_method(D_METHOD("is_handle_valid", "p_handle"), &AttributeContainer::is_handle_valid);
+	ClassDB::bind_method(D_METHOD("is_sleeping"), &AttributeContainer::is_sleeping);
 	ClassDB::bind_method(D_METHOD("remove_attribute", "p_attribute"), &AttributeContainer::remove_attribute);
 	ClassDB::bind_method(D_METHOD("remove_buff", "p_buff"), &AttributeContainer::remove_buff);
+	ClassDB::bind_method(D_METHOD("remove_buff_by_handle", "p_handle"), &AttributeContainer::remove_buff_by_handle);
+	ClassDB::bind_method(D_METHOD("remove_buff_deferred", "p_buff"), &AttributeContainer::remove_buff_deferred);
+	ClassDB::bind_method(D_METHOD("remove_buffs_with_tags", "p_tag_mask"), &AttributeContainer::remove_buffs_with_tags);
+	ClassDB::bind_method(D_METHOD("reset"), &AttributeContainer::reset);
+	ClassDB::bind_method(D_METHOD("reset_replication"), &AttributeContainer::reset_replication);
 	ClassDB::bind_method(D_METHOD("set_attribute_set", "p_attribute_set"), &AttributeContainer::set_attribute_set);
+	ClassDB::bind_method(D_METHOD("set_immunity_tags", "p_value"), &AttributeContainer::set_immunity_tags);
+	ClassDB::bind_method(D_METHOD("set_level", "p_value"), &AttributeContainer::set_level);
+	ClassDB::bind_method(D_METHOD("set_offscreen_update_tier", "p_value"), &AttributeContainer::set_offscreen_update_tier);
+	ClassDB::bind_method(D_METHOD("set_owner_peer", "p_value"), &AttributeContainer::set_owner_peer);
+	ClassDB::bind_method(D_METHOD("set_public_visibility", "p_value"), &AttributeContainer::set_public_visibility);
+	ClassDB::bind_method(D_METHOD("set_replication_precision", "p_value"), &AttributeContainer::set_replication_precision);
 	ClassDB::bind_method(D_METHOD("set_server_authoritative", "p_server_authoritative"), &AttributeContainer::set_server_authoritative);
+	ClassDB::bind_method(D_METHOD("set_update_tier", "p_value"), &AttributeContainer::set_update_tier);
+	ClassDB::bind_method(D_METHOD("set_value_deferred", "p_attribute_name", "p_value"), &AttributeContainer::set_value_deferred);
+	ClassDB::bind_method(D_METHOD("set_visibility_for", "p_peer", "p_visible"), &AttributeContainer::set_visibility_for);
+	ClassDB::bind_method(D_METHOD("set_visibility_notifier", "p_value"), &AttributeContainer::set_visibility_notifier);
 	ClassDB::bind_method(D_METHOD("setup"), &AttributeContainer::setup);
+	ClassDB::bind_method(D_METHOD("subscribe", "p_attribute_name", "p_callable", "p_min_delta"), &AttributeContainer::subscribe, DEFVAL(0.0f));
+	ClassDB::bind_method(D_METHOD("unsubscribe", "p_subscription_id"), &AttributeContainer::unsubscribe);
+	ClassDB::bind_method(D_METHOD("unwatch", "p_watch_id"), &AttributeContainer::unwatch);
+	ClassDB::bind_method(D_METHOD("watch", "p_attribute_name", "p_threshold", "p_direction"), &AttributeContainer::watch, DEFVAL(WATCH_FALLING));
 
 	/// binds properties to godot
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "attribute_set", PROPERTY_HINT_RESOURCE_TYPE, "AttributeSet"), "set_attribute_set", "get_attribute_set");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "level", PROPERTY_HINT_RANGE, "1,1000,1,or_greater"), "set_level", "get_level");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_authoritative"), "set_server_authoritative", "get_server_authoritative");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "replication_precision", PROPERTY_HINT_RANGE, "0.0001,10,0.0001"), "set_replication_precision", "get_replication_precision");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "owner_peer"), "set_owner_peer", "get_owner_peer");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "public_visibility"), "set_public_visibility", "get_public_visibility");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_tier", PROPERTY_HINT_ENUM, "Every Frame:0,Every 4 Frames:1,Every Second:2"), "set_update_tier", "get_update_tier");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "offscreen_update_tier", PROPERTY_HINT_ENUM, "Every Frame:0,Every 4 Frames:1,Every Second:2"), "set_offscreen_update_tier", "get_offscreen_update_tier");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "immunity_tags"), "set_immunity_tags", "get_immunity_tags");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "visibility_notifier", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "VisibleOnScreenNotifier2D,VisibleOnScreenNotifier3D"), "set_visibility_notifier", "get_visibility_notifier");
+
+	/// binds enum as consts
+	BIND_ENUM_CONSTANT(UPDATE_EVERY_FRAME);
+	BIND_ENUM_CONSTANT(UPDATE_EVERY_4_FRAMES);
+	BIND_ENUM_CONSTANT(UPDATE_EVERY_SECOND);
+	BIND_ENUM_CONSTANT(WATCH_FALLING);
+	BIND_ENUM_CONSTANT(WATCH_RISING);
+	BIND_ENUM_CONSTANT(WATCH_BOTH);
 
 	/// signals binding
 	ADD_SIGNAL(MethodInfo("attribute_changed", PropertyInfo(Variant::OBJECT, "attribute", PROPERTY_HINT_RESOURCE_TYPE, "RuntimeAttributeBase"), PropertyInfo(Variant::FLOAT, "previous_value"), PropertyInfo(Variant::FLOAT, "new_value")));
@@ -69,33 +161,238 @@ void AttributeContainer::_bind_methods()
 	ADD_SIGNAL(MethodInfo("buff_dequed", PropertyInfo(Variant::OBJECT, "buff", PROPERTY_HINT_RESOURCE_TYPE, "RuntimeBuff")));
 	ADD_SIGNAL(MethodInfo("buff_enqued", PropertyInfo(Variant::OBJECT, "buff", PROPERTY_HINT_RESOURCE_TYPE, "RuntimeBuff")));
 	ADD_SIGNAL(MethodInfo("buff_removed", PropertyInfo(Variant::OBJECT, "buff", PROPERTY_HINT_RESOURCE_TYPE, "RuntimeBuff")));
+	ADD_SIGNAL(MethodInfo("threshold_crossed", PropertyInfo(Variant::INT, "watch_id"), PropertyInfo(Variant::OBJECT, "attribute", PROPERTY_HINT_RESOURCE_TYPE, "RuntimeAttribute"), PropertyInfo(Variant::FLOAT, "threshold"), PropertyInfo(Variant::FLOAT, "value")));
 }
 
 void AttributeContainer::_on_attribute_changed(Ref<RuntimeAttribute> p_attribute, const float p_previous_value, const float p_new_value)
 {
-	emit_signal("attribute_changed", p_attribute, p_previous_value, p_new_value);
-	notify_derived_attributes(p_attribute);
+	invalidate_snapshot();
+	invalidate_bounds_of(p_attribute.ptr());
+	update_rates_of(p_attribute.ptr());
+
+	if (p_attribute->rate != 0.0f) {
+		/// the value moved away from where the deadline was computed
+		rate_deadline_dirty = true;
+	}
+
+	if (has_listeners(this, "attribute_changed")) {
+		emit_signal("attribute_changed", p_attribute, p_previous_value, p_new_value);
+	}
+
+	LocalVector<Subscription> *attribute_subscriptions = subscriptions.is_empty() ? nullptr : subscriptions.getptr(p_attribute.ptr());
+
+	if (attribute_subscriptions != nullptr) {
+		/// collected first, a listener may subscribe or unsubscribe while it is called
+		LocalVector<Subscription> due;
+
+		for (uint32_t i = 0; i < attribute_subscriptions->size(); i++) {
+			Subscription &subscription = (*attribute_subscriptions)[i];
+
+			if (Math::abs(p_new_value - subscription.last_value) >= subscription.min_delta && p_new_value != subscription.last_value) {
+				due.push_back(subscription);
+				subscription.last_value = p_new_value;
+			}
+		}
+
+		for (uint32_t i = 0; i < due.size(); i++) {
+			if (due[i].callable.is_valid()) {
+				due[i].callable.call(p_attribute, due[i].last_value, p_new_value);
+			}
+		}
+	}
+
+	const LocalVector<ThresholdWatch> *attribute_watches = watches.is_empty() ? nullptr : watches.getptr(p_attribute.ptr());
+
+	if (attribute_watches != nullptr) {
+		/// copied, a listener may watch or unwatch while the crossings are emitted
+		LocalVector<ThresholdWatch> crossed;
+
+		for (uint32_t i = 0; i < attribute_watches->size(); i++) {
+			const ThresholdWatch &threshold_watch = (*attribute_watches)[i];
+			bool falling = p_previous_value > threshold_watch.threshold && p_new_value <= threshold_watch.threshold;
+			bool rising = p_previous_value < threshold_watch.threshold && p_new_value >= threshold_watch.threshold;
+
+			if ((falling && threshold_watch.direction != WATCH_RISING) || (rising && threshold_watch.direction != WATCH_FALLING)) {
+				crossed.push_back(threshold_watch);
+			}
+		}
+
+		for (uint32_t i = 0; i < crossed.size(); i++) {
+			emit_signal("threshold_crossed", crossed[i].id, p_attribute, crossed[i].threshold, p_new_value);
+		}
+	}
+
+	if ((on_screen ? update_tier : offscreen_update_tier) == UPDATE_EVERY_FRAME) {
+		notify_derived_attributes(p_attribute);
+	} else if (pending_derived.find(p_attribute) < 0) {
+		/// lower tiers batch the derived propagation until the next update
+		pending_derived.push_back(p_attribute);
+	}
 }
 
-void AttributeContainer::_on_buff_applied(Ref<RuntimeBuff> p_buff)
+void AttributeContainer::_on_buff_applied(RuntimeAttribute *p_attribute, Ref<RuntimeBuff> p_buff)
 {
-	emit_signal("buff_applied", p_buff);
+	track_buff(p_buff, p_attribute, 1);
+	invalidate_snapshot();
+
+	if (has_listeners(this, "buff_applied")) {
+		emit_signal("buff_applied", p_buff);
+	}
 }
 
 void AttributeContainer::_on_buff_dequeued(Ref<RuntimeBuff> p_buff)
 {
-	emit_signal("buff_dequed", p_buff);
-	remove_buff(RuntimeBuff::to_buff(p_buff));
+	if (has_listeners(this, "buff_dequed")) {
+		emit_signal("buff_dequed", p_buff);
+	}
+
+	/// the queued instance is the one stored on the attributes, its handle removes exactly it
+	bool was_unrecorded = unrecorded;
+	unrecorded = true;
+
+	if (p_buff->handle != 0) {
+		remove_buff_by_handle(p_buff->handle);
+	} else {
+		remove_buff(RuntimeBuff::to_buff(p_buff));
+	}
+
+	unrecorded = was_unrecorded;
 }
 
 void AttributeContainer::_on_buff_enqueued(Ref<RuntimeBuff> p_buff)
 {
-	emit_signal("buff_enqued", p_buff);
+	wake_up();
+
+	if (has_listeners(this, "buff_enqued")) {
+		emit_signal("buff_enqued", p_buff);
+	}
+}
+
+void AttributeContainer::_on_buff_removed(RuntimeAttribute *p_attribute, Ref<RuntimeBuff> p_buff)
+{
+	track_buff(p_buff, p_attribute, -1);
+	invalidate_snapshot();
+
+	if (has_listeners(this, "buff_removed")) {
+		emit_signal("buff_removed", p_buff);
+	}
+}
+
+void AttributeContainer::_on_screen_entered()
+{
+	on_screen = true;
+}
+
+void AttributeContainer::_on_screen_exited()
+{
+	on_screen = false;
+}
+
+void AttributeContainer::connect_visibility_notifier()
+{
+	Object *previous = connected_notifier_id != 0 ? ObjectDB::get_instance(connected_notifier_id) : nullptr;
+
+	if (previous != nullptr) {
+		previous->disconnect("screen_entered", Callable::create(this, "_on_screen_entered"));
+		previous->disconnect("screen_exited", Callable::create(this, "_on_screen_exited"));
+	}
+
+	connected_notifier_id = 0;
+	/// without a notifier the container is always considered on screen
+	on_screen = true;
+
+	if (visibility_notifier.is_empty()) {
+		return;
+	}
+
+	Node *notifier = get_node_or_null(visibility_notifier);
+
+	ERR_FAIL_NULL_MSG(notifier, "Visibility notifier not found.");
+	ERR_FAIL_COND_MSG(!notifier->has_signal("screen_entered") || !notifier->has_signal("screen_exited"), "Visibility notifier must be a VisibleOnScreenNotifier2D or a VisibleOnScreenNotifier3D.");
+
+	notifier->connect("screen_entered", Callable::create(this, "_on_screen_entered"));
+	notifier->connect("screen_exited", Callable::create(this, "_on_screen_exited"));
+	connected_notifier_id = notifier->get_instance_id();
+	on_screen = notifier->call("is_on_screen");
+}
+
+void AttributeContainer::flush_derived_attributes()
+{
+	GGA_TRACE_SCOPE("container", "flush_derived_attributes", get_name());
+
+	/// derived attributes changing here queue their own derived attributes, the loop runs until the chain settles
+	while (pending_derived.size() > 0) {
+		LocalVector<Ref<RuntimeAttribute>> changed = pending_derived;
+		pending_derived.clear();
+
+		for (uint32_t i = 0; i < changed.size(); i++) {
+			notify_derived_attributes(changed[i]);
+		}
+	}
+}
+
+void AttributeContainer::get_replicated_values(LocalVector<float> &r_values) const
+{
+	Array _attributes = attributes.values();
+
+	r_values.resize(_attributes.size());
+
+	for (int i = 0; i < _attributes.size(); i++) {
+		Ref<RuntimeAttribute> attribute = _attributes[i];
+		r_values[i] = attribute->read_value();
+	}
+}
+
+void AttributeContainer::get_replicated_visibility(const int32_t p_peer, LocalVector<uint8_t> &r_visible) const
+{
+	Array _attributes = attributes.values();
+	int32_t owner = get_owner_peer();
+
+	if (owner == 0 && is_inside_tree()) {
+		owner = get_multiplayer_authority();
+	}
+
+	r_visible.resize(_attributes.size());
+
+	for (int i = 0; i < _attributes.size(); i++) {
+		Ref<RuntimeAttribute> attribute = _attributes[i];
+
+		switch (attribute->attribute->get_replication_mode()) {
+			case REPLICATION_PUBLIC:
+				r_visible[i] = 1;
+				break;
+			case REPLICATION_OWNER_ONLY:
+				r_visible[i] = p_peer != 0 && p_peer == owner ? 1 : 0;
+				break;
+			default:
+				r_visible[i] = 0;
+				break;
+		}
+	}
+}
+
+AttributeContainer::BuffHandleSlot *AttributeContainer::get_handle_slot(const int64_t p_handle)
+{
+	if (!is_handle_valid(p_handle)) {
+		return nullptr;
+	}
+
+	return &handle_slots[(uint32_t)(p_handle & 0xFFFFFFFF)];
 }
 
-void AttributeContainer::_on_buff_removed(Ref<RuntimeBuff> p_buff)
+bool AttributeContainer::is_broadcast_visible() const
 {
-	emit_signal("buff_removed", p_buff);
+	if (!public_visibility) {
+		return false;
+	}
+
+	for (const KeyValue<int32_t, bool> &E : peer_visibility) {
+		if (!E.value) {
+			return false;
+		}
+	}
+
+	return true;
 }
 
 bool AttributeContainer::has_attribute(Ref<AttributeBase> p_attribute)
@@ -103,29 +400,148 @@ bool AttributeContainer::has_attribute(Ref<AttributeBase> p_attribute)
 	return attributes.has(p_attribute->get_attribute_name());
 }
 
+bool AttributeContainer::is_update_due() const
+{
+	switch (on_screen ? update_tier : offscreen_update_tier) {
+		case UPDATE_EVERY_4_FRAMES:
+			return update_frames >= 4;
+		case UPDATE_EVERY_SECOND:
+			return update_elapsed >= 1.0;
+		default:
+			return true;
+	}
+}
+
+bool AttributeContainer::has_listeners(const Object *p_emitter, const StringName &p_signal)
+{
+	if (may_have_connections(p_emitter, p_signal)) {
+		return true;
+	}
+
+	skipped_signals++;
+	return false;
+}
+
 void AttributeContainer::notify_derived_attributes(Ref<RuntimeAttribute> p_runtime_attribute)
 {
+	GGA_TRACE_SCOPE("container", "notify_derived_attributes", p_runtime_attribute->get_attribute()->get_attribute_name());
+
 	if (derived_attributes.has(p_runtime_attribute->get_attribute()->get_attribute_name())) {
 		TypedArray<RuntimeAttribute> derived = derived_attributes[p_runtime_attribute->get_attribute()->get_attribute_name()];
-		Callable attribute_changed_callable = Callable::create(this, "_on_attribute_changed");
 
 		for (int i = 0; i < derived.size(); i++) {
 			Ref<RuntimeAttribute> derived_attribute = derived[i];
+			/// the bounds of a derived attribute depend on the attributes it derives from
+			derived_attribute->invalidate_bounds();
 			float previous_value = derived_attribute->get_value();
 			float current_value = derived_attribute->get_buffed_value();
 
 			if (previous_value != current_value) {
-				derived_attribute->emit_signal("attribute_changed", derived_attribute, previous_value, current_value);
+				derived_attribute->notify_attribute_changed(previous_value, current_value);
+			}
+		}
+	}
+}
+
+AttributeContainer::~AttributeContainer()
+{
+	if (recorder != nullptr) {
+		recorder->detach(this);
+	}
+
+	Array _attributes = attributes.values();
+
+	for (int i = 0; i < _attributes.size(); i++) {
+		detach_attribute(_attributes[i]);
+	}
+}
+
+void AttributeContainer::detach_attribute(const Ref<RuntimeAttribute> &p_runtime_attribute)
+{
+	for (int i = 0; i < p_runtime_attribute->buffs.size(); i++) {
+		track_buff(p_runtime_attribute->buffs[i], p_runtime_attribute.ptr(), -1);
+	}
+
+	/// the accumulated value is kept, the rate source stays in this container
+	p_runtime_attribute->settle_rate();
+	p_runtime_attribute->rate = 0.0f;
+
+	Ref<AttributeBase> base = p_runtime_attribute->attribute;
+
+	if (base.is_valid()) {
+		String sources[2] = { base->get_min_value_attribute(), base->get_max_value_attribute() };
+
+		for (int i = 0; i < 2; i++) {
+			LocalVector<RuntimeAttribute *> *bound = sources[i].is_empty() ? nullptr : bound_attributes.getptr(sources[i]);
+			int64_t index = bound != nullptr ? bound->find(p_runtime_attribute.ptr()) : -1;
+
+			if (index >= 0) {
+				bound->remove_at_unordered(index);
 			}
 		}
+
+		LocalVector<RuntimeAttribute *> *rated = base->get_rate_attribute().is_empty() ? nullptr : rate_attributes.getptr(base->get_rate_attribute());
+		int64_t index = rated != nullptr ? rated->find(p_runtime_attribute.ptr()) : -1;
+
+		if (index >= 0) {
+			rated->remove_at_unordered(index);
+		}
 	}
+
+	watches.erase(p_runtime_attribute.ptr());
+	subscriptions.erase(p_runtime_attribute.ptr());
+	rate_deadline_dirty = true;
+
+	/// a detached runtime attribute must not call back into this container anymore
+	p_runtime_attribute->attribute_container = nullptr;
 }
 
 void AttributeContainer::_physics_process(double p_delta)
 {
+	/// deferred commands are the sync point of the other threads, they run before anything else this frame
+	flush_deferred();
+
+	/// the rates accumulate over the processed time, it follows the time scale and stops while paused
+	clock += p_delta;
+	update_frames++;
+	update_elapsed += p_delta;
+
+	/// the queue time always advances, lower tiers only visit the buffs less often
 	if (buff_pool_queue) {
-		buff_pool_queue->handle_physics_process(p_delta);
+		buff_pool_queue->advance(p_delta);
+	}
+
+	if (is_update_due()) {
+		if (buff_pool_queue) {
+			buff_pool_queue->process_due();
+		}
+
+		if (rate_deadline_dirty) {
+			schedule_rate_deadline();
+		}
+
+		if (clock >= rate_deadline) {
+			settle_due_rates();
+		}
+
+		/// the snapshot reads the rated values, nothing is written and nobody is notified
+		if (has_moving_rate()) {
+			snapshot_dirty = true;
+		}
+
+		flush_derived_attributes();
+		update_frames = 0;
+		update_elapsed = 0.0;
+	}
+
+	publish_snapshot();
+
+	/// the tick is recorded last, the commands flushed at its start are recorded before it and replay in the same order
+	if (recorder != nullptr) {
+		recorder->record_tick(recorder_id, p_delta);
 	}
+
+	sleep_if_idle();
 }
 
 void AttributeContainer::_ready()
@@ -138,6 +554,16 @@ void AttributeContainer::_ready()
 
 	add_child(buff_pool_queue);
 	setup();
+	connect_visibility_notifier();
+}
+
+bool AttributeContainer::acknowledge_delta(const int64_t p_sequence, const int32_t p_peer)
+{
+	/// every peer acks the same broadcast, one ack must not move the baseline past a packet another peer lost
+	ERR_FAIL_COND_V_MSG(p_peer == 0, false, "Broadcasts are not acknowledged, encode a delta for each peer to send only the changes.");
+
+	AttributeReplication *state = peer_replication.getptr(p_peer);
+	return state != nullptr && state->acknowledge((uint32_t)p_sequence);
 }
 
 void AttributeContainer::add_attribute(Ref<AttributeBase> p_attribute)
@@ -147,168 +573,910 @@ void AttributeContainer::add_attribute(Ref<AttributeBase> p_attribute)
 	if (!has_attribute(p_attribute)) {
 		Ref<RuntimeAttribute> runtime_attribute = memnew(RuntimeAttribute);
 
-		runtime_attribute->attribute_container = this;
 		runtime_attribute->set_attribute(p_attribute);
 		runtime_attribute->set_attribute_set(attribute_set);
 		runtime_attribute->set_buffs(p_attribute->get_buffs());
 		runtime_attribute->set_value(runtime_attribute->get_initial_value());
+		/// attached last, register_attribute accounts for the initial buffs
+		runtime_attribute->attribute_container = this;
 
-		Callable attribute_changed_callable = Callable::create(this, "_on_attribute_changed");
-		Callable buff_applied_callable = Callable::create(this, "_on_buff_applied");
-		Callable buff_removed_callable = Callable::create(this, "_on_buff_removed");
-
-		if (!runtime_attribute->is_connected("attribute_changed", attribute_changed_callable)) {
-			runtime_attribute->connect("attribute_changed", attribute_changed_callable);
-		}
-
-		if (!runtime_attribute->is_connected("buff_added", buff_applied_callable)) {
-			runtime_attribute->connect("buff_added", buff_applied_callable);
-		}
-
-		if (!runtime_attribute->is_connected("buff_removed", buff_removed_callable)) {
-			runtime_attribute->connect("buff_removed", buff_removed_callable);
-		}
-
-		TypedArray<AttributeBase> base_attributes = runtime_attribute->get_derived_from();
-
-		if (base_attributes.size() > 0) {
-			int i = 0;
-
-			for (i; i < base_attributes.size(); i++) {
-				Ref<AttributeBase> base_attribute = base_attributes[i];
-				Array _derived;
+		register_attribute(runtime_attribute, runtime_attribute->get_derived_from());
+	}
+}
 
-				if (derived_attributes.has(base_attribute->get_attribute_name())) {
-					_derived = derived_attributes[base_attribute->get_attribute_name()];
-				} else {
-					_derived = Array();
-					derived_attributes[base_attribute->get_attribute_name()] = _derived;
-				}
+int64_t AttributeContainer::apply_buff(Ref<AttributeBuff> p_buff)
+{
+	ERR_FAIL_NULL_V_MSG(p_buff, 0, "Buff cannot be null, it must be an instance of a class inheriting from AttributeBuff abstract class.");
+	GGA_TRACE_SCOPE("container", "apply_buff", String(get_name()) + ":" + p_buff->get_buff_name());
 
-				_derived.push_back(runtime_attribute);
-			}
-		}
+	uint32_t ordinal = recorder != nullptr ? recorder->record_apply_buff(recorder_id, p_buff) : AttributeRecorder::NONE;
+	int64_t handle = apply_buff_internal(p_buff, -1.0f);
 
-		attributes[p_attribute->get_attribute_name()] = runtime_attribute;
+	if (recorder != nullptr) {
+		recorder->record_handle(recorder_id, ordinal, handle);
 	}
+
+	return handle;
 }
 
-void AttributeContainer::apply_buff(Ref<AttributeBuff> p_buff)
+int64_t AttributeContainer::apply_buff_internal(const Ref<AttributeBuff> &p_buff, const float p_time_left)
 {
-	ERR_FAIL_NULL_MSG(p_buff, "Buff cannot be null, it must be an instance of a class inheriting from AttributeBuff abstract class.");
+	if ((p_buff->get_tag_mask() & immunity_mask) != 0) {
+		return 0;
+	}
+
+	LocalVector<BuffInstance> stored;
 
 	if (p_buff->is_operate_overridden()) {
 		TypedArray<RuntimeAttribute> _attributes = get_attributes();
 
 		for (int i = 0; i < _attributes.size(); i++) {
 			Ref<RuntimeAttribute> runtime_attribute = _attributes[i];
+			BuffInstance instance;
 
-			if (runtime_attribute->add_buff(p_buff) && !Math::is_zero_approx(p_buff->get_duration())) {
-				buff_pool_queue->enqueue(RuntimeBuff::from_buff(p_buff));
+			if (runtime_attribute->add_buff_internal(p_buff, instance.buff) && instance.buff.is_valid()) {
+				instance.attribute = runtime_attribute.ptr();
+				stored.push_back(instance);
 			}
 		}
 	} else {
 		Ref<RuntimeAttribute> runtime_attribute = get_attribute_by_name(p_buff->get_attribute_name());
+		BuffInstance instance;
 
-		if (runtime_attribute.is_valid() && !runtime_attribute.is_null() && runtime_attribute->add_buff(p_buff)) {
-			if (!Math::is_zero_approx(p_buff->get_duration())) {
-				buff_pool_queue->enqueue(RuntimeBuff::from_buff(p_buff));
-			}
+		if (runtime_attribute.is_valid() && !runtime_attribute.is_null() && runtime_attribute->add_buff_internal(p_buff, instance.buff) && instance.buff.is_valid()) {
+			instance.attribute = runtime_attribute.ptr();
+			stored.push_back(instance);
 		}
 	}
-}
 
-void AttributeContainer::remove_attribute(Ref<AttributeBase> p_attribute)
-{
-	ERR_FAIL_NULL_MSG(p_attribute, "Attribute cannot be null, it must be an instance of a class inheriting from AttributeBase abstract class.");
+	if (stored.size() == 0) {
+		return 0;
+	}
 
-	if (has_attribute(p_attribute)) {
-		Ref<RuntimeAttribute> runtime_attribute = get_attribute_by_name(p_attribute->get_name());
+	uint32_t index;
 
-		ERR_FAIL_COND_MSG(!runtime_attribute.is_valid(), "Attribute not found in the container.");
+	if (free_handle_slots.size() > 0) {
+		index = free_handle_slots[free_handle_slots.size() - 1];
+		free_handle_slots.resize(free_handle_slots.size() - 1);
+	} else {
+		index = handle_slots.size();
+		handle_slots.push_back(BuffHandleSlot());
+	}
 
-		String attribute_name = runtime_attribute->get_attribute()->get_attribute_name();
+	BuffHandleSlot &slot = handle_slots[index];
+	int64_t handle = ((int64_t)slot.generation << 32) | (int64_t)index;
 
-		if (attributes.has(attribute_name)) {
-			runtime_attribute->disconnect("attribute_changed", Callable::create(this, "_on_attribute_changed"));
-			runtime_attribute->disconnect("buff_added", Callable::create(this, "_on_buff_applied"));
-			runtime_attribute->disconnect("buff_removed", Callable::create(this, "_on_buff_removed"));
-			attributes.erase(attribute_name);
+	slot.used = true;
+	slot.instances = stored;
+
+	for (uint32_t i = 0; i < stored.size(); i++) {
+		stored[i].buff->handle = handle;
+	}
+
+	/// the scheduler shares the stored instance, its expiry removes this application and no other stack
+	if (buff_pool_queue != nullptr && !Math::is_zero_approx(p_buff->get_duration())) {
+		if (p_time_left >= 0.0f) {
+			stored[0].buff->time_left = p_time_left;
 		}
+
+		buff_pool_queue->enqueue(stored[0].buff);
 	}
+
+	return handle;
 }
 
-void AttributeContainer::remove_buff(Ref<AttributeBuff> p_buff)
+void AttributeContainer::apply_buff_deferred(Ref<AttributeBuff> p_buff)
 {
 	ERR_FAIL_NULL_MSG(p_buff, "Buff cannot be null, it must be an instance of a class inheriting from AttributeBuff abstract class.");
 
+	AttributeCommandQueue::Command command;
+	command.type = AttributeCommandQueue::COMMAND_APPLY_BUFF;
+	command.buff = p_buff;
+	command_queue.push(command);
+	wake_up();
+}
+
+int64_t AttributeContainer::apply_delta(const PackedByteArray &p_packet)
+{
 	Array _attributes = attributes.values();
+	LocalVector<float> values;
+	LocalVector<uint32_t> changed;
 
-	for (int i = 0; i < _attributes.size(); i++) {
-		Ref<RuntimeAttribute> attribute = _attributes[i];
-		attribute->remove_buff(p_buff);
+	int32_t stream;
+
+	if (!AttributeReplication::read_stream(p_packet, stream)) {
+		return -1;
 	}
-}
 
-void AttributeContainer::setup()
-{
-	attributes.clear();
+	/// broadcasts and per peer deltas have their own sequences, each stream is checked for staleness separately
+	AttributeReplication &replication = received_replication[stream];
 
-	if (attribute_set.is_valid()) {
-		for (int i = 0; i < attribute_set->count(); i++) {
-			add_attribute(attribute_set->get_at(i));
-		}
+	get_replicated_values(values);
+
+	if (!replication.decode(p_packet, values, replication_precision, changed)) {
+		return -1;
 	}
-}
 
-Ref<RuntimeAttribute> AttributeContainer::find(Callable p_predicate) const
-{
-	Array _attributes = attributes.values();
+	for (uint32_t i = 0; i < changed.size(); i++) {
+		Ref<RuntimeAttribute> attribute = _attributes[changed[i]];
+		attribute->settle_rate();
 
-	for (int i = 0; i < _attributes.size(); i++) {
-		if (p_predicate.call(_attributes[i])) {
-			return _attributes[i];
-		}
+		float previous_value = attribute->value;
+
+		/// replicated values are already clamped by the authority, they are written as they are
+		attribute->value = values[changed[i]];
+		attribute->notify_attribute_changed(previous_value, attribute->value);
 	}
 
-	return nullptr;
+	return replication.get_last_received_sequence();
 }
 
-float AttributeContainer::find_buffed_value(Callable p_predicate) const
+PackedByteArray AttributeContainer::encode_delta(const bool p_full, const int32_t p_peer)
 {
-	Ref<RuntimeAttribute> attribute = find(p_predicate);
-	return attribute.is_valid() && !attribute.is_null() ? attribute->get_buffed_value() : 0.0f;
-}
+	if (p_peer == 0 ? !is_broadcast_visible() : !get_visibility_for(p_peer)) {
+		return PackedByteArray();
+	}
 
-float AttributeContainer::find_value(Callable p_predicate) const
-{
-	Ref<RuntimeAttribute> attribute = find(p_predicate);
-	return attribute.is_valid() && !attribute.is_null() ? attribute->get_value() : 0.0f;
-}
+	LocalVector<float> values;
+	LocalVector<uint8_t> visible;
 
-Ref<AttributeSet> AttributeContainer::get_attribute_set() const
-{
-	return attribute_set;
+	get_replicated_values(values);
+	get_replicated_visibility(p_peer, visible);
+
+	/// broadcasts are never acknowledged, each one carries every visible value
+	return peer_replication[p_peer].encode(values, visible, replication_precision, p_full || p_peer == 0, p_peer);
 }
 
-TypedArray<RuntimeAttribute> AttributeContainer::get_attributes() const
+int AttributeContainer::flush_deferred()
 {
-	return (TypedArray<RuntimeAttribute>)attributes.values();
+	AttributeCommandQueue::Command command;
+	int count = 0;
+
+	while (command_queue.pop(command)) {
+		switch (command.type) {
+			case AttributeCommandQueue::COMMAND_APPLY_BUFF:
+				apply_buff(command.buff);
+				break;
+			case AttributeCommandQueue::COMMAND_REMOVE_BUFF:
+				remove_buff(command.buff);
+				break;
+			case AttributeCommandQueue::COMMAND_SET_VALUE: {
+				Ref<RuntimeAttribute> attribute = get_attribute_by_name(command.attribute_name);
+
+				if (attribute.is_valid()) {
+					attribute->set_value(command.value);
+				}
+			} break;
+		}
+
+		count++;
+	}
+
+	return count;
 }
 
-Ref<RuntimeAttribute> AttributeContainer::get_attribute_by_name(const String &p_name) const
+void AttributeContainer::invalidate_bounds_of(const RuntimeAttribute *p_source)
 {
-	if (attributes.has(p_name)) {
-		return attributes[p_name];
+	if (bound_attributes.is_empty() || p_source->attribute.is_null()) {
+		return;
 	}
 
-	return Ref<RuntimeAttribute>();
+	const LocalVector<RuntimeAttribute *> *bound = bound_attributes.getptr(p_source->attribute->get_attribute_name());
+
+	if (bound != nullptr) {
+		for (uint32_t i = 0; i < bound->size(); i++) {
+			(*bound)[i]->invalidate_bounds();
+		}
+	}
 }
 
-float AttributeContainer::get_attribute_buffed_value_by_name(const String &p_name) const
+void AttributeContainer::invalidate_snapshot()
 {
-	Ref<RuntimeAttribute> attribute = get_attribute_by_name(p_name);
-	return attribute.is_valid() && !attribute.is_null() ? attribute->get_buffed_value() : 0.0f;
+	snapshot_dirty = true;
+	wake_up();
+}
+
+void AttributeContainer::publish_snapshot()
+{
+	if (!snapshot_dirty) {
+		return;
+	}
+
+	Array _attributes = attributes.values();
+	LocalVector<float> values;
+	LocalVector<float> buffed_values;
+
+	get_replicated_values(values);
+	buffed_values.resize(values.size());
+
+	for (int i = 0; i < _attributes.size(); i++) {
+		Ref<RuntimeAttribute> attribute = _attributes[i];
+		buffed_values[i] = attribute->get_buffed_value();
+	}
+
+	snapshot.publish(values, buffed_values);
+	snapshot_dirty = false;
+}
+
+void AttributeContainer::release_buff_handle(const Ref<RuntimeBuff> &p_buff)
+{
+	BuffHandleSlot *slot = get_handle_slot(p_buff->handle);
+
+	if (slot == nullptr) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < slot->instances.size(); i++) {
+		if (slot->instances[i].buff == p_buff) {
+			slot->instances.remove_at_unordered(i);
+			break;
+		}
+	}
+
+	if (slot->instances.size() == 0) {
+		/// the handle stays on the instance, a bumped generation makes it stale
+		slot->used = false;
+		slot->generation++;
+		free_handle_slots.push_back((uint32_t)(slot - handle_slots.ptr()));
+	}
+}
+
+void AttributeContainer::track_buff(const Ref<RuntimeBuff> &p_buff, RuntimeAttribute *p_attribute, const int32_t p_delta)
+{
+	const AttributeBuff *key = p_buff->buff.ptr();
+
+	/// the buffed value of p_attribute changes, so do the bounds and the rates bound to it
+	invalidate_bounds_of(p_attribute);
+	update_rates_of(p_attribute);
+
+	if (p_delta > 0) {
+		buff_index[key].push_back(p_attribute);
+	} else {
+		if (p_buff->handle != 0) {
+			release_buff_handle(p_buff);
+		}
+
+		LocalVector<RuntimeAttribute *> *holders = buff_index.getptr(key);
+
+		if (holders != nullptr) {
+			int64_t index = holders->find(p_attribute);
+
+			if (index >= 0) {
+				holders->remove_at_unordered(index);
+			}
+
+			if (holders->size() == 0) {
+				buff_index.erase(key);
+			}
+		}
+	}
+
+	uint64_t mask = p_buff->tag_mask;
+
+	while (mask != 0) {
+		uint32_t bit = 0;
+
+		while ((mask & ((uint64_t)1 << bit)) == 0) {
+			bit++;
+		}
+
+		mask &= ~((uint64_t)1 << bit);
+
+		if (p_delta > 0) {
+			tag_counts[bit]++;
+			active_tags |= (uint64_t)1 << bit;
+		} else if (tag_counts[bit] > 0 && --tag_counts[bit] == 0) {
+			active_tags &= ~((uint64_t)1 << bit);
+		}
+	}
+}
+
+double AttributeContainer::get_rate_deadline(const RuntimeAttribute *p_attribute) const
+{
+	double deadline = std::numeric_limits<double>::infinity();
+
+	if (!p_attribute->is_rate_moving()) {
+		return deadline;
+	}
+
+	const LocalVector<ThresholdWatch> *attribute_watches = watches.is_empty() ? nullptr : watches.getptr(p_attribute);
+	const LocalVector<Subscription> *attribute_subscriptions = subscriptions.is_empty() ? nullptr : subscriptions.getptr(p_attribute);
+
+	if (attribute_watches == nullptr && attribute_subscriptions == nullptr) {
+		return deadline;
+	}
+
+	float rate = p_attribute->rate;
+	float current_value = p_attribute->read_value();
+	bool unbounded = rate > 0.0f && Math::is_zero_approx(p_attribute->get_max_value());
+	float bound = rate > 0.0f ? p_attribute->get_max_value() : p_attribute->get_min_value();
+
+	if (attribute_watches != nullptr) {
+		for (uint32_t i = 0; i < attribute_watches->size(); i++) {
+			const ThresholdWatch &threshold_watch = (*attribute_watches)[i];
+			/// a threshold past the bound is never crossed by the rate
+			bool ahead = rate > 0.0f ? threshold_watch.threshold > current_value && (unbounded || threshold_watch.threshold <= bound) : threshold_watch.threshold < current_value && threshold_watch.threshold >= bound;
+
+			if (ahead && threshold_watch.direction != (rate > 0.0f ? WATCH_FALLING : WATCH_RISING)) {
+				deadline = MIN(deadline, clock + (double)((threshold_watch.threshold - current_value) / rate));
+			}
+		}
+	}
+
+	if (attribute_subscriptions != nullptr) {
+		for (uint32_t i = 0; i < attribute_subscriptions->size(); i++) {
+			const Subscription &subscription = (*attribute_subscriptions)[i];
+
+			if (current_value != subscription.last_value && Math::abs(current_value - subscription.last_value) >= subscription.min_delta) {
+				return clock;
+			}
+
+			float target = subscription.last_value + (rate > 0.0f ? subscription.min_delta : -subscription.min_delta);
+
+			/// the value stops at the bound, its last change is reported there
+			if (!unbounded && (rate > 0.0f ? target > bound : target < bound)) {
+				target = bound;
+			}
+
+			deadline = MIN(deadline, clock + (double)MAX((target - current_value) / rate, 0.0f));
+		}
+	}
+
+	return deadline;
+}
+
+void AttributeContainer::schedule_rate_deadline()
+{
+	rate_deadline = std::numeric_limits<double>::infinity();
+	rate_deadline_dirty = false;
+
+	for (const KeyValue<String, LocalVector<RuntimeAttribute *>> &E : rate_attributes) {
+		for (uint32_t i = 0; i < E.value.size(); i++) {
+			rate_deadline = MIN(rate_deadline, get_rate_deadline(E.value[i]));
+		}
+	}
+}
+
+void AttributeContainer::settle_due_rates()
+{
+	/// collected first, a listener may add or remove attributes while the changes are notified
+	LocalVector<Ref<RuntimeAttribute>> due;
+
+	for (const KeyValue<String, LocalVector<RuntimeAttribute *>> &E : rate_attributes) {
+		for (uint32_t i = 0; i < E.value.size(); i++) {
+			if (get_rate_deadline(E.value[i]) <= clock) {
+				due.push_back(Ref<RuntimeAttribute>(E.value[i]));
+			}
+		}
+	}
+
+	/// a value settled short of its target by rounding is rescheduled for the next update
+	rate_deadline_dirty = true;
+
+	for (uint32_t i = 0; i < due.size(); i++) {
+		Ref<RuntimeAttribute> runtime_attribute = due[i];
+
+		if (runtime_attribute->attribute_container != this) {
+			continue;
+		}
+
+		float previous_value = runtime_attribute->value;
+		runtime_attribute->settle_rate();
+
+		if (runtime_attribute->value != previous_value) {
+			runtime_attribute->notify_attribute_changed(previous_value, runtime_attribute->value);
+		}
+	}
+}
+
+bool AttributeContainer::has_moving_rate() const
+{
+	for (const KeyValue<String, LocalVector<RuntimeAttribute *>> &E : rate_attributes) {
+		for (uint32_t i = 0; i < E.value.size(); i++) {
+			if (E.value[i]->is_rate_moving()) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void AttributeContainer::sleep_if_idle()
+{
+	if (snapshot_dirty || pending_derived.size() > 0 || (buff_pool_queue != nullptr && !buff_pool_queue->is_empty())) {
+		return;
+	}
+
+	/// the clock only advances while the container processes, a moving rate keeps it awake
+	if (has_moving_rate()) {
+		return;
+	}
+
+	update_frames = 0;
+	update_elapsed = 0.0;
+
+	/// a command pushed after this store wakes the container up, one pushed before it is seen by is_empty
+	sleeping.store(true, std::memory_order_seq_cst);
+
+	if (command_queue.is_empty()) {
+		set_physics_process(false);
+	} else {
+		sleeping.store(false, std::memory_order_relaxed);
+	}
+}
+
+void AttributeContainer::update_rates_of(const RuntimeAttribute *p_source)
+{
+	if (rate_attributes.is_empty() || p_source->attribute.is_null()) {
+		return;
+	}
+
+	const LocalVector<RuntimeAttribute *> *rated = rate_attributes.getptr(p_source->attribute->get_attribute_name());
+
+	if (rated != nullptr) {
+		for (uint32_t i = 0; i < rated->size(); i++) {
+			(*rated)[i]->update_rate();
+		}
+	}
+}
+
+void AttributeContainer::wake_up()
+{
+	if (!sleeping.exchange(false, std::memory_order_seq_cst)) {
+		return;
+	}
+
+	/// commands can be pushed from other threads, the scene tree is only touched from the main thread
+	call_deferred("set_physics_process", true);
+}
+
+void AttributeContainer::register_attribute(const Ref<RuntimeAttribute> &p_runtime_attribute, const TypedArray<AttributeBase> &p_derived_from)
+{
+	for (int i = 0; i < p_derived_from.size(); i++) {
+		Ref<AttributeBase> base_attribute = p_derived_from[i];
+		Array _derived;
+
+		if (derived_attributes.has(base_attribute->get_attribute_name())) {
+			_derived = derived_attributes[base_attribute->get_attribute_name()];
+		} else {
+			_derived = Array();
+			derived_attributes[base_attribute->get_attribute_name()] = _derived;
+		}
+
+		_derived.push_back(p_runtime_attribute);
+	}
+
+	for (int i = 0; i < p_runtime_attribute->buffs.size(); i++) {
+		track_buff(p_runtime_attribute->buffs[i], p_runtime_attribute.ptr(), 1);
+	}
+
+	const String &min_source = p_runtime_attribute->attribute->get_min_value_attribute();
+	const String &max_source = p_runtime_attribute->attribute->get_max_value_attribute();
+
+	if (!min_source.is_empty()) {
+		bound_attributes[min_source].push_back(p_runtime_attribute.ptr());
+	}
+
+	if (!max_source.is_empty() && max_source != min_source) {
+		bound_attributes[max_source].push_back(p_runtime_attribute.ptr());
+	}
+
+	const String &rate_source = p_runtime_attribute->attribute->get_rate_attribute();
+
+	if (!rate_source.is_empty()) {
+		rate_attributes[rate_source].push_back(p_runtime_attribute.ptr());
+		p_runtime_attribute->update_rate();
+	}
+
+	attributes[p_runtime_attribute->attribute->get_attribute_name()] = p_runtime_attribute;
+	/// the attributes rated by this one may have been registered before it
+	update_rates_of(p_runtime_attribute.ptr());
+	invalidate_snapshot();
+}
+
+void AttributeContainer::remove_attribute(Ref<AttributeBase> p_attribute)
+{
+	ERR_FAIL_NULL_MSG(p_attribute, "Attribute cannot be null, it must be an instance of a class inheriting from AttributeBase abstract class.");
+
+	if (has_attribute(p_attribute)) {
+		Ref<RuntimeAttribute> runtime_attribute = get_attribute_by_name(p_attribute->get_attribute_name());
+
+		ERR_FAIL_COND_MSG(!runtime_attribute.is_valid(), "Attribute not found in the container.");
+
+		String attribute_name = runtime_attribute->get_attribute()->get_attribute_name();
+
+		if (attributes.has(attribute_name)) {
+			detach_attribute(runtime_attribute);
+			attributes.erase(attribute_name);
+			invalidate_snapshot();
+		}
+	}
+}
+
+void AttributeContainer::remove_buff(Ref<AttributeBuff> p_buff)
+{
+	ERR_FAIL_NULL_MSG(p_buff, "Buff cannot be null, it must be an instance of a class inheriting from AttributeBuff abstract class.");
+
+	if (recorder != nullptr && !unrecorded) {
+		recorder->record_remove_buff(recorder_id, p_buff);
+	}
+
+	const LocalVector<RuntimeAttribute *> *holders = buff_index.getptr(p_buff.ptr());
+
+	if (holders != nullptr) {
+		/// only the attributes storing this very buff are visited, once each, as removing mutates the index
+		LocalVector<Ref<RuntimeAttribute>> affected;
+
+		for (uint32_t i = 0; i < holders->size(); i++) {
+			Ref<RuntimeAttribute> attribute = (*holders)[i];
+
+			if (affected.find(attribute) < 0) {
+				affected.push_back(attribute);
+			}
+		}
+
+		for (uint32_t i = 0; i < affected.size(); i++) {
+			affected[i]->remove_buff_internal(p_buff);
+		}
+
+		return;
+	}
+
+	/// an equal buff may be stored under another instance, they are compared by value
+	Array _attributes = attributes.values();
+
+	for (int i = 0; i < _attributes.size(); i++) {
+		Ref<RuntimeAttribute> attribute = _attributes[i];
+		attribute->remove_buff_internal(p_buff);
+	}
+}
+
+bool AttributeContainer::remove_buff_by_handle(const int64_t p_handle)
+{
+	if (recorder != nullptr && !unrecorded) {
+		recorder->record_remove_handle(recorder_id, p_handle);
+	}
+
+	BuffHandleSlot *slot = get_handle_slot(p_handle);
+
+	if (slot == nullptr) {
+		return false;
+	}
+
+	/// removing an instance releases it from the slot, the instances are copied first
+	LocalVector<BuffInstance> instances = slot->instances;
+
+	for (uint32_t i = 0; i < instances.size(); i++) {
+		if (!instances[i].attribute->remove_runtime_buff(instances[i].buff)) {
+			release_buff_handle(instances[i].buff);
+		}
+	}
+
+	return true;
+}
+
+void AttributeContainer::remove_buff_deferred(Ref<AttributeBuff> p_buff)
+{
+	ERR_FAIL_NULL_MSG(p_buff, "Buff cannot be null, it must be an instance of a class inheriting from AttributeBuff abstract class.");
+
+	AttributeCommandQueue::Command command;
+	command.type = AttributeCommandQueue::COMMAND_REMOVE_BUFF;
+	command.buff = p_buff;
+	command_queue.push(command);
+	wake_up();
+}
+
+int AttributeContainer::remove_buffs_with_tags(const int64_t p_tag_mask)
+{
+	if (recorder != nullptr && !unrecorded) {
+		recorder->record_remove_tags(recorder_id, String(), p_tag_mask);
+	}
+
+	if ((active_tags & (uint64_t)p_tag_mask) == 0) {
+		return 0;
+	}
+
+	Array _attributes = attributes.values();
+	int count = 0;
+
+	for (int i = 0; i < _attributes.size(); i++) {
+		Ref<RuntimeAttribute> attribute = _attributes[i];
+		count += attribute->remove_buffs_with_tags_internal(p_tag_mask);
+	}
+
+	return count;
+}
+
+void AttributeContainer::reset()
+{
+	if (recorder != nullptr && !unrecorded) {
+		recorder->record_reset(recorder_id);
+	}
+
+	AttributeCommandQueue::Command command;
+
+	/// the queued commands target the previous life of the entity, they are dropped without being executed
+	while (command_queue.pop(command)) {
+	}
+
+	if (buff_pool_queue != nullptr) {
+		buff_pool_queue->clear();
+	}
+
+	pending_derived.clear();
+	update_frames = 0;
+	update_elapsed = 0.0;
+
+	Ref<AttributeSetTemplate> baked = attribute_set.is_valid() ? attribute_set->get_template() : Ref<AttributeSetTemplate>();
+	Array _attributes = attributes.values();
+	LocalVector<float> previous_values;
+
+	previous_values.resize(_attributes.size());
+
+	for (int i = 0; i < _attributes.size(); i++) {
+		Ref<RuntimeAttribute> runtime_attribute = _attributes[i];
+		int index = baked.is_valid() ? baked->find(runtime_attribute->attribute->get_attribute_name()) : -1;
+
+		previous_values[i] = runtime_attribute->read_value();
+
+		/// the accumulated value is dropped with the rest, the rates are read again once every value is restored
+		runtime_attribute->rate = 0.0f;
+
+		if (index < 0) {
+			/// attributes added with add_attribute have no baked entry, their defaults are read from the resource
+			runtime_attribute->set_buffs(runtime_attribute->attribute->get_buffs());
+			runtime_attribute->value = runtime_attribute->get_initial_value();
+			runtime_attribute->invalidate_bounds();
+		} else {
+			const AttributeSetTemplate::Entry &entry = baked->get_entries()[index];
+
+			for (int j = 0; j < runtime_attribute->buffs.size(); j++) {
+				track_buff(runtime_attribute->buffs[j], runtime_attribute.ptr(), -1);
+			}
+
+			runtime_attribute->buffs = entry.instantiate_buffs();
+			runtime_attribute->invalidate_aggregates();
+
+			for (int j = 0; j < runtime_attribute->buffs.size(); j++) {
+				track_buff(runtime_attribute->buffs[j], runtime_attribute.ptr(), 1);
+			}
+
+			runtime_attribute->invalidate_bounds();
+			seed_attribute(runtime_attribute, entry);
+		}
+	}
+
+	for (int i = 0; i < _attributes.size(); i++) {
+		Ref<RuntimeAttribute> runtime_attribute = _attributes[i];
+
+		if (!runtime_attribute->attribute->get_rate_attribute().is_empty()) {
+			runtime_attribute->update_rate();
+		}
+	}
+
+	invalidate_snapshot();
+
+	/// the restored values are reported once every attribute is restored, so the listeners read a consistent container
+	for (int i = 0; i < _attributes.size(); i++) {
+		Ref<RuntimeAttribute> runtime_attribute = _attributes[i];
+		float current_value = runtime_attribute->read_value();
+
+		if (current_value != previous_values[i]) {
+			runtime_attribute->notify_attribute_changed(previous_values[i], current_value);
+		} else if (pending_derived.find(runtime_attribute) < 0) {
+			/// the value is the same but the buffs were restored, the derived attributes are evaluated again on the next update
+			pending_derived.push_back(runtime_attribute);
+		}
+	}
+}
+
+void AttributeContainer::reset_replication()
+{
+	received_replication.clear();
+	peer_replication.clear();
+}
+
+void AttributeContainer::seed_attribute(const Ref<RuntimeAttribute> &p_runtime_attribute, const AttributeSetTemplate::Entry &p_entry)
+{
+	if (p_entry.attribute->has_level_scaling()) {
+		/// the template is baked at level 1, the scaled values are evaluated natively at the container level
+		float initial_value = p_runtime_attribute->get_initial_value();
+		p_runtime_attribute->value = Math::clamp(initial_value, p_runtime_attribute->get_min_value(), p_runtime_attribute->get_max_value());
+		/// bound sources may not be registered yet, the bounds are computed again on the next read
+		p_runtime_attribute->invalidate_bounds();
+		return;
+	}
+
+	p_runtime_attribute->value = p_entry.initial_value;
+
+	/// the baked bounds are only valid when they do not depend on another attribute of the container
+	if (p_entry.attribute->get_min_value_attribute().is_empty() && p_entry.attribute->get_max_value_attribute().is_empty()) {
+		p_runtime_attribute->cached_min_value = p_entry.min_value;
+		p_runtime_attribute->cached_max_value = p_entry.max_value;
+		p_runtime_attribute->bounds_dirty = false;
+	}
+}
+
+void AttributeContainer::setup()
+{
+	Array _attributes = attributes.values();
+
+	for (int i = 0; i < _attributes.size(); i++) {
+		detach_attribute(_attributes[i]);
+	}
+
+	attributes.clear();
+	derived_attributes.clear();
+	reset_replication();
+
+	pending_derived.clear();
+	buff_index.clear();
+	bound_attributes.clear();
+	rate_attributes.clear();
+	invalidate_snapshot();
+
+	if (attribute_set.is_null()) {
+		return;
+	}
+
+	Ref<AttributeSetTemplate> baked = attribute_set->get_template();
+	const LocalVector<AttributeSetTemplate::Entry> &entries = baked->get_entries();
+
+	for (uint32_t i = 0; i < entries.size(); i++) {
+		const AttributeSetTemplate::Entry &entry = entries[i];
+
+		if (entry.attribute.is_null() || attributes.has(entry.attribute_name)) {
+			continue;
+		}
+
+		/// no script virtual is called here, everything comes from the template
+		Ref<RuntimeAttribute> runtime_attribute = memnew(RuntimeAttribute);
+
+		runtime_attribute->attribute_container = this;
+		runtime_attribute->attribute = entry.attribute;
+		runtime_attribute->attribute_set = attribute_set;
+		runtime_attribute->buffs = entry.instantiate_buffs();
+		runtime_attribute->derived_from = entry.derived_from;
+		runtime_attribute->has_derived_from = true;
+		seed_attribute(runtime_attribute, entry);
+		register_attribute(runtime_attribute, entry.derived_from);
+	}
+}
+
+int64_t AttributeContainer::subscribe(const String &p_attribute_name, const Callable &p_callable, const float p_min_delta)
+{
+	Ref<RuntimeAttribute> attribute = get_attribute_by_name(p_attribute_name);
+
+	ERR_FAIL_COND_V_MSG(attribute.is_null(), 0, "Attribute not found in the container: " + p_attribute_name + ".");
+	ERR_FAIL_COND_V_MSG(!p_callable.is_valid(), 0, "Cannot subscribe an invalid callable.");
+
+	/// crossings and deltas are measured from the stored value, it starts from the value read now
+	attribute->settle_rate();
+	rate_deadline_dirty = true;
+
+	Subscription subscription;
+	subscription.id = next_subscription_id++;
+	subscription.callable = p_callable;
+	subscription.min_delta = p_min_delta > 0.0f ? p_min_delta : 0.0f;
+	subscription.last_value = attribute->get_value();
+
+	subscriptions[attribute.ptr()].push_back(subscription);
+
+	return subscription.id;
+}
+
+bool AttributeContainer::unsubscribe(const int64_t p_subscription_id)
+{
+	for (KeyValue<const RuntimeAttribute *, LocalVector<Subscription>> &E : subscriptions) {
+		for (uint32_t i = 0; i < E.value.size(); i++) {
+			if (E.value[i].id == p_subscription_id) {
+				E.value.remove_at(i);
+				rate_deadline_dirty = true;
+
+				if (E.value.size() == 0) {
+					const RuntimeAttribute *key = E.key;
+					subscriptions.erase(key);
+				}
+
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool AttributeContainer::unwatch(const int64_t p_watch_id)
+{
+	for (KeyValue<const RuntimeAttribute *, LocalVector<ThresholdWatch>> &E : watches) {
+		for (uint32_t i = 0; i < E.value.size(); i++) {
+			if (E.value[i].id == p_watch_id) {
+				E.value.remove_at_unordered(i);
+				rate_deadline_dirty = true;
+
+				if (E.value.size() == 0) {
+					const RuntimeAttribute *key = E.key;
+					watches.erase(key);
+				}
+
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+int64_t AttributeContainer::watch(const String &p_attribute_name, const float p_threshold, const int p_direction)
+{
+	Ref<RuntimeAttribute> attribute = get_attribute_by_name(p_attribute_name);
+
+	ERR_FAIL_COND_V_MSG(attribute.is_null(), 0, "Attribute not found in the container: " + p_attribute_name + ".");
+	ERR_FAIL_COND_V_MSG(p_direction < WATCH_FALLING || p_direction > WATCH_BOTH, 0, "Invalid watch direction.");
+
+	/// a crossing the rate made before the watch existed is not reported
+	attribute->settle_rate();
+	rate_deadline_dirty = true;
+
+	ThresholdWatch threshold_watch;
+	threshold_watch.id = next_watch_id++;
+	threshold_watch.threshold = p_threshold;
+	threshold_watch.direction = (WatchDirection)p_direction;
+
+	watches[attribute.ptr()].push_back(threshold_watch);
+
+	return threshold_watch.id;
+}
+
+Ref<RuntimeAttribute> AttributeContainer::find(Callable p_predicate) const
+{
+	Array _attributes = attributes.values();
+
+	for (int i = 0; i < _attributes.size(); i++) {
+		if (p_predicate.call(_attributes[i])) {
+			return _attributes[i];
+		}
+	}
+
+	return nullptr;
+}
+
+float AttributeContainer::find_buffed_value(Callable p_predicate) const
+{
+	Ref<RuntimeAttribute> attribute = find(p_predicate);
+	return attribute.is_valid() && !attribute.is_null() ? attribute->get_buffed_value() : 0.0f;
+}
+
+float AttributeContainer::find_value(Callable p_predicate) const
+{
+	Ref<RuntimeAttribute> attribute = find(p_predicate);
+	return attribute.is_valid() && !attribute.is_null() ? attribute->get_value() : 0.0f;
+}
+
+Ref<AttributeSet> AttributeContainer::get_attribute_set() const
+{
+	return attribute_set;
+}
+
+TypedArray<RuntimeAttribute> AttributeContainer::get_attributes() const
+{
+	return (TypedArray<RuntimeAttribute>)attributes.values();
+}
+
+Ref<RuntimeAttribute> AttributeContainer::get_attribute_by_name(const String &p_name) const
+{
+	if (attributes.has(p_name)) {
+		return attributes[p_name];
+	}
+
+	return Ref<RuntimeAttribute>();
+}
+
+float AttributeContainer::get_attribute_buffed_value_by_name(const String &p_name) const
+{
+	Ref<RuntimeAttribute> attribute = get_attribute_by_name(p_name);
+	return attribute.is_valid() && !attribute.is_null() ? attribute->get_buffed_value() : 0.0f;
 }
 
 float AttributeContainer::get_attribute_value_by_name(const String &p_name) const
@@ -317,17 +1485,207 @@ float AttributeContainer::get_attribute_value_by_name(const String &p_name) cons
 	return attribute.is_valid() && !attribute.is_null() ? attribute->get_value() : 0.0f;
 }
 
+float AttributeContainer::get_buffed_value_snapshot(const int p_index) const
+{
+	float value;
+	float buffed_value;
+
+	ERR_FAIL_COND_V_MSG(p_index < 0 || !snapshot.read((uint32_t)p_index, value, buffed_value), 0.0f, "Snapshot index out of bounds.");
+	return buffed_value;
+}
+
+PackedByteArray AttributeContainer::get_dirty_mask(const int32_t p_peer) const
+{
+	LocalVector<float> values;
+	LocalVector<uint8_t> visible;
+
+	get_replicated_values(values);
+	get_replicated_visibility(p_peer, visible);
+
+	const AttributeReplication *state = peer_replication.getptr(p_peer);
+
+	if (state == nullptr) {
+		/// nothing was acknowledged yet, every visible attribute is dirty
+		return AttributeReplication().get_dirty_mask(values, visible, replication_precision);
+	}
+
+	return state->get_dirty_mask(values, visible, replication_precision);
+}
+
+int32_t AttributeContainer::get_owner_peer() const
+{
+	return owner_peer;
+}
+
+bool AttributeContainer::get_public_visibility() const
+{
+	return public_visibility;
+}
+
+float AttributeContainer::get_replication_precision() const
+{
+	return replication_precision;
+}
+
 bool AttributeContainer::get_server_authoritative() const
 {
 	return server_authoritative;
 }
 
+bool AttributeContainer::get_visibility_for(const int32_t p_peer) const
+{
+	const bool *visible = peer_visibility.getptr(p_peer);
+	return visible != nullptr ? *visible : public_visibility;
+}
+
+int AttributeContainer::get_tag_count(const StringName &p_tag) const
+{
+	int32_t bit = AttributeTags::find(p_tag);
+	return bit >= 0 ? (int)tag_counts[bit] : 0;
+}
+
+int64_t AttributeContainer::get_skipped_signal_count() const
+{
+	return (int64_t)skipped_signals;
+}
+
+PackedStringArray AttributeContainer::get_immunity_tags() const
+{
+	return immunity_tags;
+}
+
+int AttributeContainer::get_level() const
+{
+	return level;
+}
+
+int AttributeContainer::get_offscreen_update_tier() const
+{
+	return (int)offscreen_update_tier;
+}
+
+int AttributeContainer::get_snapshot_size() const
+{
+	return (int)snapshot.get_size();
+}
+
+NodePath AttributeContainer::get_visibility_notifier() const
+{
+	return visibility_notifier;
+}
+
+bool AttributeContainer::has_buff_with_tags(const int64_t p_tag_mask) const
+{
+	return (active_tags & (uint64_t)p_tag_mask) != 0;
+}
+
+bool AttributeContainer::is_handle_valid(const int64_t p_handle) const
+{
+	uint32_t index = (uint32_t)(p_handle & 0xFFFFFFFF);
+	uint32_t generation = (uint32_t)((uint64_t)p_handle >> 32);
+
+	return index < handle_slots.size() && handle_slots[index].used && handle_slots[index].generation == generation;
+}
+
+bool AttributeContainer::is_sleeping() const
+{
+	return sleeping.load(std::memory_order_relaxed);
+}
+
+int AttributeContainer::get_update_tier() const
+{
+	return (int)update_tier;
+}
+
+float AttributeContainer::get_value_snapshot(const int p_index) const
+{
+	float value;
+	float buffed_value;
+
+	ERR_FAIL_COND_V_MSG(p_index < 0 || !snapshot.read((uint32_t)p_index, value, buffed_value), 0.0f, "Snapshot index out of bounds.");
+	return value;
+}
+
 void AttributeContainer::set_attribute_set(const Ref<AttributeSet> &p_attribute_set)
 {
 	attribute_set = p_attribute_set;
 	setup();
 }
 
+void AttributeContainer::set_immunity_tags(const PackedStringArray &p_value)
+{
+	immunity_tags = p_value;
+	immunity_mask = AttributeTags::make_mask(p_value);
+}
+
+void AttributeContainer::set_level(const int p_value)
+{
+	ERR_FAIL_COND_MSG(p_value < 1, "Level must be at least 1.");
+
+	if (p_value == level) {
+		return;
+	}
+
+	if (recorder != nullptr && !unrecorded) {
+		recorder->record_set_level(recorder_id, p_value);
+	}
+
+	int previous_level = level;
+	bool was_unrecorded = unrecorded;
+	Array _attributes = attributes.values();
+
+	level = p_value;
+	/// the rescaled values replay with the level change, they are not recorded on their own
+	unrecorded = true;
+
+	for (int i = 0; i < _attributes.size(); i++) {
+		Ref<RuntimeAttribute> runtime_attribute = _attributes[i];
+
+		/// a bound attribute may be scaled even if this one is not
+		runtime_attribute->invalidate_bounds();
+
+		if (!runtime_attribute->attribute->has_level_scaling()) {
+			continue;
+		}
+
+		float previous_scale = runtime_attribute->attribute->get_level_scale(previous_level);
+		float scale = runtime_attribute->attribute->get_level_scale(level);
+
+		if (previous_scale == scale) {
+			continue;
+		}
+
+		/// the value keeps its ratio to the scale, a damaged mob stays damaged after leveling up
+		float previous_value = runtime_attribute->get_value();
+		runtime_attribute->set_value(previous_scale != 0.0f ? previous_value * scale / previous_scale : runtime_attribute->get_initial_value());
+	}
+
+	unrecorded = was_unrecorded;
+	invalidate_snapshot();
+}
+
+void AttributeContainer::set_offscreen_update_tier(const int p_value)
+{
+	ERR_FAIL_COND_MSG(p_value < UPDATE_EVERY_FRAME || p_value > UPDATE_EVERY_SECOND, "Invalid update tier.");
+	offscreen_update_tier = (UpdateTier)p_value;
+}
+
+void AttributeContainer::set_owner_peer(const int32_t p_value)
+{
+	owner_peer = p_value;
+}
+
+void AttributeContainer::set_public_visibility(const bool p_value)
+{
+	public_visibility = p_value;
+}
+
+void AttributeContainer::set_replication_precision(const float p_value)
+{
+	ERR_FAIL_COND_MSG(p_value <= 0.0f, "Replication precision must be greater than zero.");
+	replication_precision = p_value;
+}
+
 void AttributeContainer::set_server_authoritative(const bool p_server_authoritative)
 {
 	server_authoritative = p_server_authoritative;
@@ -336,3 +1694,39 @@ void AttributeContainer::set_server_authoritative(const bool p_server_authoritat
 		buff_pool_queue->set_server_authoritative(server_authoritative);
 	}
 }
+
+void AttributeContainer::set_value_deferred(const String &p_attribute_name, const float p_value)
+{
+	AttributeCommandQueue::Command command;
+	command.type = AttributeCommandQueue::COMMAND_SET_VALUE;
+	command.attribute_name = p_attribute_name;
+	command.value = p_value;
+	command_queue.push(command);
+	wake_up();
+}
+
+void AttributeContainer::set_update_tier(const int p_value)
+{
+	ERR_FAIL_COND_MSG(p_value < UPDATE_EVERY_FRAME || p_value > UPDATE_EVERY_SECOND, "Invalid update tier.");
+	update_tier = (UpdateTier)p_value;
+}
+
+void AttributeContainer::set_visibility_for(const int32_t p_peer, const bool p_visible)
+{
+	peer_visibility[p_peer] = p_visible;
+
+	if (!p_visible) {
+		/// the peer will receive a full state when the container becomes visible again
+		peer_replication.erase(p_peer);
+	}
+}
+
+void AttributeContainer::set_visibility_notifier(const NodePath &p_value)
+{
+	visibility_notifier = p_value;
+
+	/// before ready, _ready connects the notifier
+	if (is_node_ready()) {
+		connect_visibility_notifier();
+	}
+}
@@ -30,7 +30,16 @@
 #ifndef GGA_ATTRIBUTE_CONTAINER_HPP
 #define GGA_ATTRIBUTE_CONTAINER_HPP
 
+#include "attribute_command_queue.hpp"
+#include "attribute_replication.hpp"
+#include "attribute_set_template.hpp"
+#include "attribute_snapshot.hpp"
+#include "attribute_tags.hpp"
+
 #include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+
+#include <limits>
 
 using namespace godot;
 
@@ -38,15 +47,72 @@ namespace gga
 {
 	class AttributeBase;
 	class AttributeBuff;
+	class AttributeRecorder;
 	class AttributeSet;
 	class BuffPoolQueue;
 	class RuntimeAttribute;
 	class RuntimeBuff;
 
+	enum UpdateTier
+	{
+		/// @brief Timed buffs and derived attributes are updated every physics frame.
+		UPDATE_EVERY_FRAME = 0,
+		/// @brief Timed buffs and derived attributes are updated every 4 physics frames.
+		UPDATE_EVERY_4_FRAMES = 1,
+		/// @brief Timed buffs and derived attributes are updated every second.
+		UPDATE_EVERY_SECOND = 2,
+	};
+
+	enum WatchDirection
+	{
+		/// @brief The watch fires when the value drops to or below the threshold.
+		WATCH_FALLING = 0,
+		/// @brief The watch fires when the value rises to or above the threshold.
+		WATCH_RISING = 1,
+		/// @brief The watch fires on both crossings.
+		WATCH_BOTH = 2,
+	};
+
 	class AttributeContainer : public Node
 	{
 		GDCLASS(AttributeContainer, Node);
 
+		friend class AttributeRecorder;
+		friend class AttributeReplayer;
+		friend class RuntimeAttribute;
+
+		/// @brief A buff instance stored on an attribute.
+		struct BuffInstance
+		{
+			RuntimeAttribute *attribute = nullptr;
+			Ref<RuntimeBuff> buff;
+		};
+
+		/// @brief A slot of the handle table, the handle is the generation in the high 32 bits and the slot index in the low 32 bits.
+		struct BuffHandleSlot
+		{
+			uint32_t generation = 1;
+			bool used = false;
+			LocalVector<BuffInstance> instances;
+		};
+
+		/// @brief A threshold watched on an attribute.
+		struct ThresholdWatch
+		{
+			int64_t id = 0;
+			float threshold = 0.0f;
+			WatchDirection direction = WATCH_FALLING;
+		};
+
+		/// @brief A listener subscribed to an attribute.
+		struct Subscription
+		{
+			int64_t id = 0;
+			Callable callable;
+			float min_delta = 0.0f;
+			float last_value = 0.0f;
+		};
+
 	protected:
 		/// @brief Bind methods to Godot.
 		static void _bind_methods();
@@ -55,36 +121,197 @@ namespace gga
 		/// @brief TypedArray of attributes.
 		Dictionary attributes;
 		/// @brief Buff pool queue. It is used to store buffs that have a limited duration.
-		BuffPoolQueue *buff_pool_queue;
+		BuffPoolQueue *buff_pool_queue = nullptr;
 		/// @brief Derived attributes. These are attributes that are calculated from other attributes.
 		Dictionary derived_attributes;
 		/// @brief Server authoritative. If set to true, the container will only process buffs on the server.
-		bool server_authoritative;
+		bool server_authoritative = false;
+		/// @brief The number of signal emissions skipped because nobody was listening.
+		uint64_t skipped_signals = 0;
+		/// @brief Replication state of the deltas received from the authority, one per stream. Stream 0 is the broadcast.
+		HashMap<int32_t, AttributeReplication> received_replication;
+		/// @brief Replication state of the deltas sent to each peer. Peer 0 is used for broadcasts.
+		HashMap<int32_t, AttributeReplication> peer_replication;
+		/// @brief The precision used to quantize replicated values.
+		float replication_precision = 0.01f;
+		/// @brief The peer owning the container, 0 means the multiplayer authority.
+		int32_t owner_peer = 0;
+		/// @brief Per peer visibility overrides.
+		HashMap<int32_t, bool> peer_visibility;
+		/// @brief Whether the container is visible to peers without an override.
+		bool public_visibility = true;
+		/// @brief The level used to scale the initial, minimum and maximum values of the attributes.
+		int level = 1;
+		/// @brief Commands pushed from any thread, drained at the start of each physics frame.
+		AttributeCommandQueue command_queue;
+		/// @brief Values published at the end of each physics frame for readers on other threads.
+		AttributeSnapshot snapshot;
+		/// @brief True if a value or a buff changed since the last published snapshot.
+		bool snapshot_dirty = true;
+		/// @brief True while physics processing is turned off because there is nothing to do.
+		std::atomic<bool> sleeping{ false };
+		/// @brief How often timed buffs and derived attributes are updated.
+		UpdateTier update_tier = UPDATE_EVERY_FRAME;
+		/// @brief The tier used while the visibility notifier is off screen.
+		UpdateTier offscreen_update_tier = UPDATE_EVERY_SECOND;
+		/// @brief Path to a VisibleOnScreenNotifier2D or VisibleOnScreenNotifier3D switching the update tier.
+		NodePath visibility_notifier;
+		/// @brief False while the visibility notifier is off screen.
+		bool on_screen = true;
+		/// @brief Instance id of the connected visibility notifier, 0 if none is connected.
+		uint64_t connected_notifier_id = 0;
+		/// @brief Physics frames elapsed since the last update.
+		uint32_t update_frames = 0;
+		/// @brief Time elapsed since the last update.
+		double update_elapsed = 0.0;
+		/// @brief Processed time of the container, the sum of the physics deltas. Rates accumulate over it.
+		double clock = 0.0;
+		/// @brief The clock time at which a rate moves a watched or subscribed value far enough to be reported.
+		double rate_deadline = std::numeric_limits<double>::infinity();
+		/// @brief True if a rate, a value, a bound, a watch or a subscription changed since the deadline was computed.
+		bool rate_deadline_dirty = false;
+		/// @brief Attributes whose derived attributes are waiting for the next update.
+		LocalVector<Ref<RuntimeAttribute>> pending_derived;
+		/// @brief Buffs carrying one of these tags are rejected.
+		PackedStringArray immunity_tags;
+		/// @brief The immunity tags interned into a bitmask.
+		uint64_t immunity_mask = 0;
+		/// @brief For each tag bit, the number of buffs stored on the attributes carrying it.
+		uint32_t tag_counts[AttributeTags::MAX_TAGS] = {};
+		/// @brief The tags carried by at least one stored buff.
+		uint64_t active_tags = 0;
+		/// @brief Reverse index from each stored buff to the attributes storing it, once per stack.
+		HashMap<const AttributeBuff *, LocalVector<RuntimeAttribute *>> buff_index;
+		/// @brief The handle table of the applied buffs.
+		LocalVector<BuffHandleSlot> handle_slots;
+		/// @brief Released slots of the handle table.
+		LocalVector<uint32_t> free_handle_slots;
+		/// @brief For each attribute name, the attributes whose minimum or maximum value is bound to it.
+		HashMap<String, LocalVector<RuntimeAttribute *>> bound_attributes;
+		/// @brief For each attribute name, the attributes whose rate is bound to it.
+		HashMap<String, LocalVector<RuntimeAttribute *>> rate_attributes;
+		/// @brief The thresholds watched on each attribute.
+		HashMap<const RuntimeAttribute *, LocalVector<ThresholdWatch>> watches;
+		/// @brief The id of the next watch.
+		int64_t next_watch_id = 1;
+		/// @brief The listeners subscribed to each attribute.
+		HashMap<const RuntimeAttribute *, LocalVector<Subscription>> subscriptions;
+		/// @brief The id of the next subscription.
+		int64_t next_subscription_id = 1;
+		/// @brief The recorder logging the traffic of the container, null when not recorded.
+		AttributeRecorder *recorder = nullptr;
+		/// @brief The id of the container in the recorder log.
+		uint32_t recorder_id = 0;
+		/// @brief True while an expired buff is removed or the level rescales the values, the nested changes are not recorded.
+		bool unrecorded = false;
 
-		/// @brief Handles the attribute_changed signal.
+		/// @brief Handles an attribute change, called directly by the RuntimeAttribute.
 		/// @param p_attribute The attribute that changed.
 		/// @param p_previous_value The previous value of the attribute.
 		/// @param p_new_value The new value of the attribute.
 		void _on_attribute_changed(Ref<RuntimeAttribute> p_attribute, const float p_previous_value, const float p_new_value);
-		/// @brief Handles the buff_applied signal.
+		/// @brief Handles a buff added to an attribute, called directly by the RuntimeAttribute.
+		/// @param p_attribute The attribute storing the buff.
 		/// @param p_buff The buff that was applied.
-		void _on_buff_applied(Ref<RuntimeBuff> p_buff);
+		void _on_buff_applied(RuntimeAttribute *p_attribute, Ref<RuntimeBuff> p_buff);
 		/// @brief Handles the buff_dequeued signal.
 		/// @param p_buff The buff that was dequeued.
 		void _on_buff_dequeued(Ref<RuntimeBuff> p_buff);
 		/// @brief Handles the buff_enqueued signal.
 		/// @param p_buff The buff that was enqueued.
 		void _on_buff_enqueued(Ref<RuntimeBuff> p_buff);
-		/// @brief Handles the buff_removed signal.
+		/// @brief Handles a buff removed from an attribute, called directly by the RuntimeAttribute.
+		/// @param p_attribute The attribute that stored the buff.
 		/// @param p_buff The buff that was removed.
-		void _on_buff_removed(Ref<RuntimeBuff> p_buff);
+		void _on_buff_removed(RuntimeAttribute *p_attribute, Ref<RuntimeBuff> p_buff);
+		/// @brief Handles the screen_entered signal of the visibility notifier.
+		void _on_screen_entered();
+		/// @brief Handles the screen_exited signal of the visibility notifier.
+		void _on_screen_exited();
+		/// @brief Notifies the derived attributes of the attributes changed since the last update.
+		void flush_derived_attributes();
+		/// @brief Disconnects the previous visibility notifier, connects the one at the visibility_notifier path and reads its state.
+		void connect_visibility_notifier();
+		/// @brief Returns if the update tier interval elapsed.
+		/// @return True if timed buffs and derived attributes must be updated this frame.
+		bool is_update_due() const;
+		/// @brief Collects the attribute values in replication order.
+		/// @param r_values The collected values.
+		void get_replicated_values(LocalVector<float> &r_values) const;
+		/// @brief Collects which attributes a peer is allowed to receive, in replication order.
+		/// @param p_peer The receiving peer, 0 for a broadcast.
+		/// @param r_visible For each attribute, 1 if the peer can receive it, 0 otherwise.
+		void get_replicated_visibility(const int32_t p_peer, LocalVector<uint8_t> &r_visible) const;
+		/// @brief Returns whether a broadcast can be sent. A broadcast reaches every peer, so it is refused if any peer can not see the container.
+		/// @return True if the container is visible to every peer.
+		bool is_broadcast_visible() const;
+		/// @brief Detaches a runtime attribute from the container.
+		/// @param p_runtime_attribute The runtime attribute.
+		void detach_attribute(const Ref<RuntimeAttribute> &p_runtime_attribute);
+		/// @brief Applies a buff without recording it.
+		/// @param p_buff The buff to apply.
+		/// @param p_time_left The time left of a timed buff, negative for its whole duration.
+		/// @return The handle of this application, 0 if the buff was not stored.
+		int64_t apply_buff_internal(const Ref<AttributeBuff> &p_buff, const float p_time_left);
+		/// @brief Returns the used slot of a handle.
+		/// @param p_handle The handle.
+		/// @return The slot, null if the handle is stale or invalid.
+		BuffHandleSlot *get_handle_slot(const int64_t p_handle);
 		/// @brief Checks if the container has a specific attribute.
 		bool has_attribute(Ref<AttributeBase> p_attribute);
+		/// @brief Checks if a signal of the container or of one of its runtime objects has listeners. Skipped emissions are counted.
+		/// @param p_emitter The object emitting the signal.
+		/// @param p_signal The signal name.
+		/// @return True if the signal must be emitted.
+		bool has_listeners(const Object *p_emitter, const StringName &p_signal);
+		/// @brief Marks the cached bounds of the attributes bound to an attribute as outdated.
+		/// @param p_source The attribute whose buffed value may have changed.
+		void invalidate_bounds_of(const RuntimeAttribute *p_source);
+		/// @brief Marks the snapshot as outdated, waking the container up.
+		void invalidate_snapshot();
+		/// @brief Publishes the values and buffed values if they changed since the last snapshot.
+		void publish_snapshot();
+		/// @brief Releases a buff instance from its handle, the handle becomes stale when its last instance is released.
+		/// @param p_buff The buff instance.
+		void release_buff_handle(const Ref<RuntimeBuff> &p_buff);
+		/// @brief Updates the per tag counts, the reverse index and the bound attributes when a buff is stored on or removed from an attribute.
+		/// @param p_buff The buff.
+		/// @param p_attribute The attribute storing the buff.
+		/// @param p_delta 1 if the buff was stored, -1 if it was removed.
+		void track_buff(const Ref<RuntimeBuff> &p_buff, RuntimeAttribute *p_attribute, const int32_t p_delta);
+		/// @brief Settles the attributes whose rate is bound to an attribute and reads their new rate.
+		/// @param p_source The attribute whose buffed value may have changed.
+		void update_rates_of(const RuntimeAttribute *p_source);
+		/// @brief Computes when the rate of an attribute moves its value across a watched threshold, by the minimum delta of a subscription or to its bound.
+		/// @param p_attribute The rated attribute.
+		/// @return The clock time, infinity if no watch or subscription is reached.
+		double get_rate_deadline(const RuntimeAttribute *p_attribute) const;
+		/// @brief Computes the earliest rate deadline of the watched and subscribed attributes.
+		void schedule_rate_deadline();
+		/// @brief Writes the value accumulated by the rates whose deadline passed and notifies the change.
+		void settle_due_rates();
+		/// @brief Returns whether a rate still moves a value.
+		/// @return True if a value changes over time.
+		bool has_moving_rate() const;
+		/// @brief Turns physics processing off if no timed buff, command, snapshot or moving rate is pending.
+		void sleep_if_idle();
+		/// @brief Turns physics processing back on. Safe to call from any thread.
+		void wake_up();
+		/// @brief Wires a new runtime attribute into the container. No signal is connected, the runtime attribute calls the container hooks directly.
+		/// @param p_runtime_attribute The runtime attribute.
+		/// @param p_derived_from The attributes the runtime attribute derives from.
+		void register_attribute(const Ref<RuntimeAttribute> &p_runtime_attribute, const TypedArray<AttributeBase> &p_derived_from);
+		/// @brief Writes the initial value and bounds of a runtime attribute from its baked entry, scaled by the container level.
+		/// @param p_runtime_attribute The runtime attribute.
+		/// @param p_entry The baked entry of the attribute.
+		void seed_attribute(const Ref<RuntimeAttribute> &p_runtime_attribute, const AttributeSetTemplate::Entry &p_entry);
 		/// @brief Notifies derived attributes that an attribute has changed.
 		/// @param p_runtime_attribute The attribute that changed.
 		void notify_derived_attributes(Ref<RuntimeAttribute> p_runtime_attribute);
 
 	public:
+		/// @brief Destructor, detaches the runtime attributes still referenced elsewhere.
+		~AttributeContainer();
 		/// @brief Override of the _physics_process method.
 		/// @param p_delta The delta time.
 		void _physics_process(double p_delta) override;
@@ -93,17 +320,82 @@ namespace gga
 		/// @brief Adds an attribute to the container.
 		/// @param p_attribute The attribute to add.
 		void add_attribute(Ref<AttributeBase> p_attribute);
+		/// @brief Acknowledges a delta packet received by the remote peer. The acknowledged state becomes the baseline of the next deltas.
+		/// @param p_sequence The sequence of the acknowledged packet.
+		/// @param p_peer The peer that acknowledged the packet, 0 for a broadcast.
+		/// @return True if the sequence was waiting for an ack, false otherwise.
+		bool acknowledge_delta(const int64_t p_sequence, const int32_t p_peer = 0);
 		/// @brief Adds a buff to the container.
 		/// @param p_buff The buff to add.
-		void apply_buff(Ref<AttributeBuff> p_buff);
+		/// @return A handle to the applied instances, 0 if no instance was stored.
+		int64_t apply_buff(Ref<AttributeBuff> p_buff);
+		/// @brief Queues a buff application. Safe to call from any thread, the buff is applied on the next flush.
+		/// @param p_buff The buff to apply.
+		void apply_buff_deferred(Ref<AttributeBuff> p_buff);
+		/// @brief Applies a delta packet produced by encode_delta on the remote container.
+		/// @param p_packet The packet to apply.
+		/// @return The sequence of the applied packet, or -1 if the packet is stale or malformed.
+		int64_t apply_delta(const PackedByteArray &p_packet);
+		/// @brief Encodes the attributes changed since the last state acknowledged by a peer, skipping the attributes the peer can not see.
+		/// @param p_full If true, every visible attribute is encoded.
+		/// @param p_peer The receiving peer, 0 for a broadcast which only contains public attributes.
+		/// @return The delta packet, empty if the container is not visible to the peer.
+		PackedByteArray encode_delta(const bool p_full = false, const int32_t p_peer = 0);
+		/// @brief Executes the queued commands in the order they were queued. Called at the start of each physics frame.
+		/// @return The number of executed commands.
+		int flush_deferred();
 		/// @brief Removes an attribute from the container.
 		/// @param p_attribute The attribute to remove.
 		void remove_attribute(Ref<AttributeBase> p_attribute);
 		/// @brief Removes a buff from the container.
 		/// @param p_buff The buff to remove.
 		void remove_buff(Ref<AttributeBuff> p_buff);
-		/// @brief Setups the container.
+		/// @brief Removes exactly the instances applied by apply_buff.
+		/// @param p_handle The handle returned by apply_buff.
+		/// @return True if the handle was still valid.
+		bool remove_buff_by_handle(const int64_t p_handle);
+		/// @brief Removes every buff having at least one of the given tags, in a single pass.
+		/// @param p_tag_mask The tags mask, see AttributeBuff::tags_to_mask.
+		/// @return The number of buffs removed.
+		int remove_buffs_with_tags(const int64_t p_tag_mask);
+		/// @brief Queues a buff removal. Safe to call from any thread, the buff is removed on the next flush.
+		/// @param p_buff The buff to remove.
+		void remove_buff_deferred(Ref<AttributeBuff> p_buff);
+		/// @brief Restores the initial values and default buffs of every attribute, dropping the applied buffs, the timed buffs and the queued commands.
+		/// Runtime attributes, value slots and handle slots are reused, which makes pooled entities cheaper to recycle than with setup.
+		void reset();
+		/// @brief Forgets every replication baseline and sequence.
+		void reset_replication();
+		/// @brief Queues an attribute value change. Safe to call from any thread, the value is set on the next flush.
+		/// @param p_attribute_name The name of the attribute.
+		/// @param p_value The value to set.
+		void set_value_deferred(const String &p_attribute_name, const float p_value);
+		/// @brief Sets the visibility of the container for a peer. Hiding the container forgets the peer baseline.
+		/// @param p_peer The peer.
+		/// @param p_visible The visibility.
+		void set_visibility_for(const int32_t p_peer, const bool p_visible);
+		/// @brief Setups the container. Runtime attributes are instantiated from the attribute set baked template.
 		void setup();
+		/// @brief Subscribes a callable to the changes of a single attribute. Changes of other attributes do not reach it.
+		/// @param p_attribute_name The name of the attribute.
+		/// @param p_callable The callable, called with the runtime attribute, the value it last received and the new value.
+		/// @param p_min_delta The callable is only called once the value moved by at least this amount since the value it last received.
+		/// @return The subscription id, 0 if the attribute is not found.
+		int64_t subscribe(const String &p_attribute_name, const Callable &p_callable, const float p_min_delta = 0.0f);
+		/// @brief Removes a subscription.
+		/// @param p_subscription_id The id returned by subscribe.
+		/// @return True if the subscription existed.
+		bool unsubscribe(const int64_t p_subscription_id);
+		/// @brief Removes a watch.
+		/// @param p_watch_id The id returned by watch.
+		/// @return True if the watch existed.
+		bool unwatch(const int64_t p_watch_id);
+		/// @brief Watches an attribute value crossing a threshold. The crossings are evaluated natively on every value change, threshold_crossed is only emitted when one happens.
+		/// @param p_attribute_name The name of the attribute.
+		/// @param p_threshold The threshold.
+		/// @param p_direction The crossing direction, see WatchDirection.
+		/// @return The watch id, 0 if the attribute is not found.
+		int64_t watch(const String &p_attribute_name, const float p_threshold, const int p_direction = WATCH_FALLING);
 
 		/// @brief Finds an attribute in the container.
 		/// @param p_predicate The predicate to use to find the attribute.
@@ -136,16 +428,104 @@ namespace gga
 		/// @param p_name The name of the attribute to get.
 		/// @return The base value of the attribute with the given name.
 		float get_attribute_value_by_name(const String &p_name) const;
+		/// @brief Returns the dirty bitmask of the attributes, one bit per attribute, compared to the last state acknowledged by a peer.
+		/// @param p_peer The receiving peer, 0 for a broadcast.
+		/// @return The dirty bitmask.
+		PackedByteArray get_dirty_mask(const int32_t p_peer = 0) const;
+		/// @brief Returns the peer owning the container.
+		/// @return The owner peer, 0 means the multiplayer authority.
+		int32_t get_owner_peer() const;
+		/// @brief Returns whether the container is visible to peers without an override.
+		/// @return The public visibility.
+		bool get_public_visibility() const;
+		/// @brief Returns the replication precision.
+		/// @return The replication precision.
+		float get_replication_precision() const;
 		/// @brief Returns the server authoritative value.
 		/// @return The server authoritative value.
 		bool get_server_authoritative() const;
+		/// @brief Returns the buffed value of an attribute as published at the end of the last physics frame. Safe to call from any thread.
+		/// @param p_index The index of the attribute, in the order of get_attributes.
+		/// @return The buffed value.
+		float get_buffed_value_snapshot(const int p_index) const;
+		/// @brief Returns the number of attributes of the last published snapshot. Safe to call from any thread.
+		/// @return The number of attributes.
+		int get_snapshot_size() const;
+		/// @brief Returns the tags of the buffs the container is immune to.
+		/// @return The immunity tags.
+		PackedStringArray get_immunity_tags() const;
+		/// @brief Returns the level used to scale the attribute values.
+		/// @return The level.
+		int get_level() const;
+		/// @brief Returns the update tier used while the visibility notifier is off screen.
+		/// @return The offscreen update tier.
+		int get_offscreen_update_tier() const;
+		/// @brief Returns how many buffs stored on the attributes carry a tag.
+		/// @param p_tag The tag.
+		/// @return The number of buffs.
+		int get_tag_count(const StringName &p_tag) const;
+		/// @brief Returns the number of signal emissions skipped because nobody was listening.
+		/// @return The skipped signal emissions.
+		int64_t get_skipped_signal_count() const;
+		/// @brief Returns how often timed buffs and derived attributes are updated.
+		/// @return The update tier.
+		int get_update_tier() const;
+		/// @brief Returns the value of an attribute as published at the end of the last physics frame. Safe to call from any thread.
+		/// @param p_index The index of the attribute, in the order of get_attributes.
+		/// @return The value.
+		float get_value_snapshot(const int p_index) const;
+		/// @brief Returns the path of the visibility notifier switching the update tier.
+		/// @return The visibility notifier path.
+		NodePath get_visibility_notifier() const;
+		/// @brief Returns whether the container is visible to a peer.
+		/// @param p_peer The peer.
+		/// @return True if the peer receives the container deltas.
+		bool get_visibility_for(const int32_t p_peer) const;
+		/// @brief Returns whether a stored buff carries at least one of the given tags.
+		/// @param p_tag_mask The tags mask, see AttributeBuff::tags_to_mask.
+		/// @return True if a buff carries one of the tags.
+		bool has_buff_with_tags(const int64_t p_tag_mask) const;
+		/// @brief Returns whether a handle still refers to applied buff instances.
+		/// @param p_handle The handle returned by apply_buff.
+		/// @return True if the handle is valid.
+		bool is_handle_valid(const int64_t p_handle) const;
+		/// @brief Returns whether the container is out of the physics loop because it has nothing to process.
+		/// @return True if the container is sleeping.
+		bool is_sleeping() const;
 		/// @brief Sets the attributes of the container.
 		/// @param p_attribute_set The attributes to set.
 		void set_attribute_set(const Ref<AttributeSet> &p_attribute_set);
+		/// @brief Sets the tags of the buffs the container is immune to. Immune buffs are rejected before any script is called.
+		/// @param p_value The immunity tags.
+		void set_immunity_tags(const PackedStringArray &p_value);
+		/// @brief Sets the level used to scale the attribute values. On a live container the bounds are evaluated again and each scaled value keeps its ratio to the scale.
+		/// @param p_value The level, at least 1.
+		void set_level(const int p_value);
+		/// @brief Sets the update tier used while the visibility notifier is off screen.
+		/// @param p_value The offscreen update tier.
+		void set_offscreen_update_tier(const int p_value);
+		/// @brief Sets the peer owning the container.
+		/// @param p_value The owner peer, 0 means the multiplayer authority.
+		void set_owner_peer(const int32_t p_value);
+		/// @brief Sets whether the container is visible to peers without an override.
+		/// @param p_value The public visibility.
+		void set_public_visibility(const bool p_value);
+		/// @brief Sets the replication precision.
+		/// @param p_value The replication precision.
+		void set_replication_precision(const float p_value);
 		/// @brief Sets the server authoritative value.
 		/// @param p_server_authoritative The server authoritative value to set.
 		void set_server_authoritative(const bool p_server_authoritative);
+		/// @brief Sets how often timed buffs and derived attributes are updated. Expirations are caught up exactly on the next update.
+		/// @param p_value The update tier.
+		void set_update_tier(const int p_value);
+		/// @brief Sets the path of a VisibleOnScreenNotifier2D or VisibleOnScreenNotifier3D. While it is off screen the offscreen update tier is used.
+		/// @param p_value The visibility notifier path.
+		void set_visibility_notifier(const NodePath &p_value);
 	};
 } //namespace gga
 
+VARIANT_ENUM_CAST(gga::UpdateTier);
+VARIANT_ENUM_CAST(gga::WatchDirection);
+
 #endif
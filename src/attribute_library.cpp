@@ -0,0 +1,647 @@
+/**************************************************************************/
+/*  attribute_library.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "attribute_library.hpp"
+#include "attribute.hpp"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstring>
+
+using namespace gga;
+
+namespace
+{
+	/// @brief How a resource is stored in a library.
+	enum EntryKind : uint8_t
+	{
+		/// @brief The properties of a resource without script, packed.
+		ENTRY_NATIVE = 0,
+		/// @brief The path of a resource saved in its own file.
+		ENTRY_PATH = 1,
+		/// @brief A resource with a script, embedded with its properties.
+		ENTRY_EMBEDDED = 2,
+	};
+
+	enum BuffFlags : uint8_t
+	{
+		BUFF_TRANSIENT = 1,
+		BUFF_UNIQUE = 2,
+		BUFF_HAS_OPERATION = 4,
+	};
+
+	/// @brief Appends little endian values to a buffer.
+	struct LibraryWriter
+	{
+		LocalVector<uint8_t> data;
+
+		template <typename T>
+		void write(const T p_value)
+		{
+			uint32_t offset = data.size();
+			data.resize(offset + sizeof(T));
+			memcpy(data.ptr() + offset, &p_value, sizeof(T));
+		}
+
+		void write_bytes(const PackedByteArray &p_bytes)
+		{
+			write<uint32_t>(p_bytes.size());
+
+			uint32_t offset = data.size();
+			data.resize(offset + p_bytes.size());
+
+			if (p_bytes.size() > 0) {
+				memcpy(data.ptr() + offset, p_bytes.ptr(), p_bytes.size());
+			}
+		}
+
+		void write_string(const String &p_value)
+		{
+			CharString utf8 = p_value.utf8();
+
+			write<uint32_t>(utf8.length());
+
+			uint32_t offset = data.size();
+			data.resize(offset + utf8.length());
+
+			if (utf8.length() > 0) {
+				memcpy(data.ptr() + offset, utf8.get_data(), utf8.length());
+			}
+		}
+	};
+
+	/// @brief Reads little endian values from a buffer, every read fails once the buffer is exhausted.
+	struct LibraryReader
+	{
+		const uint8_t *data = nullptr;
+		int64_t size = 0;
+		int64_t offset = 0;
+		bool failed = false;
+
+		template <typename T>
+		T read()
+		{
+			T value = T();
+
+			if (failed || offset + (int64_t)sizeof(T) > size) {
+				failed = true;
+				return value;
+			}
+
+			memcpy(&value, data + offset, sizeof(T));
+			offset += sizeof(T);
+
+			return value;
+		}
+
+		PackedByteArray read_bytes()
+		{
+			uint32_t length = read<uint32_t>();
+			PackedByteArray bytes;
+
+			if (failed || offset + length > size) {
+				failed = true;
+				return bytes;
+			}
+
+			bytes.resize(length);
+
+			if (length > 0) {
+				memcpy(bytes.ptrw(), data + offset, length);
+			}
+
+			offset += length;
+
+			return bytes;
+		}
+
+		String read_string()
+		{
+			uint32_t length = read<uint32_t>();
+
+			if (failed || offset + length > size) {
+				failed = true;
+				return String();
+			}
+
+			String value = String::utf8((const char *)data + offset, length);
+			offset += length;
+
+			return value;
+		}
+	};
+
+	/// @brief The buffs written in a library, each one once.
+	struct BuffTable
+	{
+		LocalVector<Ref<AttributeBuff>> buffs;
+		HashMap<const AttributeBuff *, uint32_t> indices;
+
+		uint32_t index_of(const Ref<AttributeBuff> &p_buff)
+		{
+			const uint32_t *index = indices.getptr(p_buff.ptr());
+
+			if (index != nullptr) {
+				return *index;
+			}
+
+			indices.insert(p_buff.ptr(), buffs.size());
+			buffs.push_back(p_buff);
+
+			return buffs.size() - 1;
+		}
+	};
+
+	/// @brief Returns how a resource is stored.
+	/// @param p_resource The resource.
+	/// @param p_native_class The class packed natively.
+	/// @return The entry kind.
+	EntryKind get_entry_kind(const Ref<Resource> &p_resource, const char *p_native_class)
+	{
+		if (p_resource->get_script().get_type() == Variant::NIL && p_resource->get_class() == p_native_class) {
+			return ENTRY_NATIVE;
+		}
+
+		String path = p_resource->get_path();
+
+		/// built-in resources have a path local to the file owning them
+		if (!path.is_empty() && path.find("::") < 0) {
+			return ENTRY_PATH;
+		}
+
+		return ENTRY_EMBEDDED;
+	}
+
+	/// @brief Writes the common header of an entry, returns true if the entry must be packed natively.
+	bool write_entry(LibraryWriter &r_writer, const Ref<Resource> &p_resource, const char *p_native_class)
+	{
+		EntryKind kind = get_entry_kind(p_resource, p_native_class);
+		r_writer.write<uint8_t>(kind);
+
+		if (kind == ENTRY_PATH) {
+			r_writer.write_string(p_resource->get_path());
+		} else if (kind == ENTRY_EMBEDDED) {
+			r_writer.write_bytes(UtilityFunctions::var_to_bytes_with_objects(p_resource));
+		}
+
+		return kind == ENTRY_NATIVE;
+	}
+
+	/// @brief Reads the common header of an entry, returns the resource if it was not packed natively.
+	Ref<Resource> read_entry(LibraryReader &r_reader, EntryKind &r_kind)
+	{
+		r_kind = (EntryKind)r_reader.read<uint8_t>();
+
+		if (r_kind == ENTRY_PATH) {
+			return ResourceLoader::get_singleton()->load(r_reader.read_string());
+		} else if (r_kind == ENTRY_EMBEDDED) {
+			return UtilityFunctions::bytes_to_var_with_objects(r_reader.read_bytes());
+		} else if (r_kind != ENTRY_NATIVE) {
+			r_reader.failed = true;
+		}
+
+		return Ref<Resource>();
+	}
+
+	void write_buff(LibraryWriter &r_writer, const Ref<AttributeBuff> &p_buff)
+	{
+		if (!write_entry(r_writer, p_buff, "AttributeBuff")) {
+			return;
+		}
+
+		Ref<AttributeOperation> operation = p_buff->get_operation();
+		PackedStringArray tags = p_buff->get_tags();
+		uint8_t flags = 0;
+
+		flags |= p_buff->get_transient() ? BUFF_TRANSIENT : 0;
+		flags |= p_buff->get_unique() ? BUFF_UNIQUE : 0;
+		flags |= operation.is_valid() ? BUFF_HAS_OPERATION : 0;
+
+		r_writer.write_string(p_buff->get_buff_name());
+		r_writer.write_string(p_buff->get_attribute_name());
+		r_writer.write<float>(p_buff->get_duration());
+		r_writer.write<int32_t>(p_buff->get_max_applies());
+		r_writer.write<uint8_t>(flags);
+
+		if (operation.is_valid()) {
+			r_writer.write<uint8_t>((uint8_t)operation->get_operand());
+			r_writer.write<float>(operation->get_value());
+		}
+
+		r_writer.write<uint32_t>(tags.size());
+
+		for (int i = 0; i < tags.size(); i++) {
+			r_writer.write_string(tags[i]);
+		}
+	}
+
+	Ref<AttributeBuff> read_buff(LibraryReader &r_reader)
+	{
+		EntryKind kind;
+		Ref<Resource> resource = read_entry(r_reader, kind);
+
+		if (kind != ENTRY_NATIVE) {
+			return resource;
+		}
+
+		Ref<AttributeBuff> buff = memnew(AttributeBuff);
+
+		buff->set_buff_name(r_reader.read_string());
+		buff->set_attribute_name(r_reader.read_string());
+		buff->set_duration(r_reader.read<float>());
+		buff->set_max_applies(r_reader.read<int32_t>());
+
+		uint8_t flags = r_reader.read<uint8_t>();
+
+		buff->set_transient((flags & BUFF_TRANSIENT) != 0);
+		buff->set_unique((flags & BUFF_UNIQUE) != 0);
+
+		if ((flags & BUFF_HAS_OPERATION) != 0) {
+			Ref<AttributeOperation> operation = memnew(AttributeOperation);
+			operation->set_operand(r_reader.read<uint8_t>());
+			operation->set_value(r_reader.read<float>());
+			buff->set_operation(operation);
+		}
+
+		uint32_t tag_count = r_reader.read<uint32_t>();
+		PackedStringArray tags;
+
+		for (uint32_t i = 0; i < tag_count && !r_reader.failed; i++) {
+			tags.push_back(r_reader.read_string());
+		}
+
+		buff->set_tags(tags);
+
+		return buff;
+	}
+} //namespace
+
+#pragma region AttributeLibrary
+
+void AttributeLibrary::_bind_methods()
+{
+	ClassDB::bind_method(D_METHOD("add_attribute_set", "p_id", "p_attribute_set"), &AttributeLibrary::add_attribute_set);
+	ClassDB::bind_method(D_METHOD("add_buff", "p_id", "p_buff"), &AttributeLibrary::add_buff);
+	ClassDB::bind_method(D_METHOD("get_attribute_set", "p_id"), &AttributeLibrary::get_attribute_set);
+	ClassDB::bind_method(D_METHOD("get_attribute_set_ids"), &AttributeLibrary::get_attribute_set_ids);
+	ClassDB::bind_method(D_METHOD("get_attribute_sets"), &AttributeLibrary::get_attribute_sets);
+	ClassDB::bind_method(D_METHOD("get_buff", "p_id"), &AttributeLibrary::get_buff);
+	ClassDB::bind_method(D_METHOD("get_buff_ids"), &AttributeLibrary::get_buff_ids);
+	ClassDB::bind_method(D_METHOD("get_buffs"), &AttributeLibrary::get_buffs);
+	ClassDB::bind_method(D_METHOD("set_attribute_sets", "p_value"), &AttributeLibrary::set_attribute_sets);
+	ClassDB::bind_method(D_METHOD("set_buffs", "p_value"), &AttributeLibrary::set_buffs);
+
+	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "attribute_sets"), "set_attribute_sets", "get_attribute_sets");
+	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "buffs"), "set_buffs", "get_buffs");
+}
+
+void AttributeLibrary::add_buff(const String &p_id, const Ref<AttributeBuff> &p_buff)
+{
+	ERR_FAIL_NULL_MSG(p_buff, "Buff cannot be null.");
+	buffs[p_id] = p_buff;
+	emit_changed();
+}
+
+void AttributeLibrary::add_attribute_set(const String &p_id, const Ref<AttributeSet> &p_attribute_set)
+{
+	ERR_FAIL_NULL_MSG(p_attribute_set, "Attribute set cannot be null.");
+	attribute_sets[p_id] = p_attribute_set;
+	emit_changed();
+}
+
+Ref<AttributeBuff> AttributeLibrary::get_buff(const String &p_id) const
+{
+	return buffs.get(p_id, Variant());
+}
+
+PackedStringArray AttributeLibrary::get_buff_ids() const
+{
+	return PackedStringArray(buffs.keys());
+}
+
+Dictionary AttributeLibrary::get_buffs() const
+{
+	return buffs;
+}
+
+Ref<AttributeSet> AttributeLibrary::get_attribute_set(const String &p_id) const
+{
+	return attribute_sets.get(p_id, Variant());
+}
+
+PackedStringArray AttributeLibrary::get_attribute_set_ids() const
+{
+	return PackedStringArray(attribute_sets.keys());
+}
+
+Dictionary AttributeLibrary::get_attribute_sets() const
+{
+	return attribute_sets;
+}
+
+void AttributeLibrary::set_buffs(const Dictionary &p_value)
+{
+	buffs = p_value;
+	emit_changed();
+}
+
+void AttributeLibrary::set_attribute_sets(const Dictionary &p_value)
+{
+	attribute_sets = p_value;
+	emit_changed();
+}
+
+#pragma endregion
+
+#pragma region AttributeLibraryLoader
+
+void AttributeLibraryLoader::_bind_methods()
+{
+}
+
+PackedStringArray AttributeLibraryLoader::_get_recognized_extensions() const
+{
+	PackedStringArray extensions;
+	extensions.push_back("galib");
+	return extensions;
+}
+
+String AttributeLibraryLoader::_get_resource_type(const String &p_path) const
+{
+	return p_path.get_extension().to_lower() == "galib" ? "AttributeLibrary" : "";
+}
+
+bool AttributeLibraryLoader::_handles_type(const StringName &p_type) const
+{
+	return p_type == StringName("AttributeLibrary");
+}
+
+Variant AttributeLibraryLoader::_load(const String &p_path, const String &p_original_path, bool p_use_sub_threads, int32_t p_cache_mode) const
+{
+	/// the whole file is read at once, then decoded from memory
+	PackedByteArray bytes = FileAccess::get_file_as_bytes(p_path);
+	ERR_FAIL_COND_V_MSG(bytes.size() == 0, (int64_t)ERR_FILE_CANT_OPEN, "Cannot read the attribute library " + p_path + ".");
+
+	LibraryReader reader;
+	reader.data = bytes.ptr();
+	reader.size = bytes.size();
+
+	ERR_FAIL_COND_V_MSG(reader.read<uint32_t>() != AttributeLibrarySaver::MAGIC, (int64_t)ERR_FILE_UNRECOGNIZED, "Not an attribute library: " + p_path + ".");
+	ERR_FAIL_COND_V_MSG(reader.read<uint32_t>() != AttributeLibrarySaver::VERSION, (int64_t)ERR_FILE_UNRECOGNIZED, "Unsupported attribute library version: " + p_path + ".");
+
+	Ref<AttributeLibrary> library = memnew(AttributeLibrary);
+	LocalVector<Ref<AttributeBuff>> buff_table;
+	Dictionary buffs;
+	Dictionary attribute_sets;
+
+	uint32_t count = reader.read<uint32_t>();
+
+	/// the smallest entry is a path or embedded entry with an empty payload: its kind and the payload length
+	ERR_FAIL_COND_V_MSG(reader.offset + (int64_t)count * (int64_t)(sizeof(uint8_t) + sizeof(uint32_t)) > reader.size, (int64_t)ERR_FILE_CORRUPT, "Attribute library is corrupt: " + p_path + ".");
+	buff_table.reserve(count);
+
+	for (uint32_t i = 0; i < count && !reader.failed; i++) {
+		buff_table.push_back(read_buff(reader));
+	}
+
+	count = reader.read<uint32_t>();
+
+	for (uint32_t i = 0; i < count && !reader.failed; i++) {
+		String id = reader.read_string();
+		uint32_t index = reader.read<uint32_t>();
+
+		ERR_FAIL_COND_V_MSG(index >= buff_table.size(), (int64_t)ERR_FILE_CORRUPT, "Attribute library is corrupt: " + p_path + ".");
+		buffs[id] = buff_table[index];
+	}
+
+	count = reader.read<uint32_t>();
+
+	for (uint32_t i = 0; i < count && !reader.failed; i++) {
+		String id = reader.read_string();
+		EntryKind kind;
+		Ref<AttributeSet> attribute_set = read_entry(reader, kind);
+
+		if (kind == ENTRY_NATIVE) {
+			TypedArray<AttributeBase> attributes;
+			String set_name = reader.read_string();
+			uint32_t attribute_count = reader.read<uint32_t>();
+
+			for (uint32_t j = 0; j < attribute_count && !reader.failed; j++) {
+				Ref<AttributeBase> attribute = read_entry(reader, kind);
+
+				if (kind == ENTRY_NATIVE) {
+					Ref<Attribute> native = memnew(Attribute);
+
+					native->set_attribute_name(reader.read_string());
+					native->set_initial_value(reader.read<float>());
+					native->set_min_value(reader.read<float>());
+					native->set_max_value(reader.read<float>());
+					native->set_replication_mode(reader.read<uint8_t>());
+					native->set_aggregation_mode(reader.read<uint8_t>());
+					native->set_min_value_attribute(reader.read_string());
+					native->set_max_value_attribute(reader.read_string());
+					native->set_rate_attribute(reader.read_string());
+
+					PackedFloat32Array scaling_table;
+					uint32_t scaling_count = reader.read<uint32_t>();
+
+					ERR_FAIL_COND_V_MSG(reader.offset + (int64_t)scaling_count * (int64_t)sizeof(float) > reader.size, (int64_t)ERR_FILE_CORRUPT, "Attribute library is corrupt: " + p_path + ".");
+					scaling_table.resize(scaling_count);
+
+					for (int k = 0; k < scaling_table.size() && !reader.failed; k++) {
+						scaling_table[k] = reader.read<float>();
+					}
+
+					/// the baked table is loaded as explicit values, the curve is not needed anymore
+					native->set_scaling_values(scaling_table);
+
+					TypedArray<AttributeBuff> attribute_buffs;
+					uint32_t buff_count = reader.read<uint32_t>();
+
+					for (uint32_t k = 0; k < buff_count && !reader.failed; k++) {
+						uint32_t index = reader.read<uint32_t>();
+						ERR_FAIL_COND_V_MSG(index >= buff_table.size(), (int64_t)ERR_FILE_CORRUPT, "Attribute library is corrupt: " + p_path + ".");
+						attribute_buffs.push_back(buff_table[index]);
+					}
+
+					native->set_buffs(attribute_buffs);
+					attribute = native;
+				}
+
+				attributes.push_back(attribute);
+			}
+
+			attribute_set = Ref<AttributeSet>(memnew(AttributeSet));
+			attribute_set->set_set_name(set_name);
+			attribute_set->set_attributes(attributes);
+		}
+
+		attribute_sets[id] = attribute_set;
+	}
+
+	ERR_FAIL_COND_V_MSG(reader.failed, (int64_t)ERR_FILE_CORRUPT, "Attribute library is truncated: " + p_path + ".");
+
+	library->set_buffs(buffs);
+	library->set_attribute_sets(attribute_sets);
+
+	return library;
+}
+
+#pragma endregion
+
+#pragma region AttributeLibrarySaver
+
+void AttributeLibrarySaver::_bind_methods()
+{
+}
+
+PackedStringArray AttributeLibrarySaver::_get_recognized_extensions(const Ref<Resource> &p_resource) const
+{
+	PackedStringArray extensions;
+
+	if (Object::cast_to<AttributeLibrary>(p_resource.ptr()) != nullptr) {
+		extensions.push_back("galib");
+	}
+
+	return extensions;
+}
+
+bool AttributeLibrarySaver::_recognize(const Ref<Resource> &p_resource) const
+{
+	return Object::cast_to<AttributeLibrary>(p_resource.ptr()) != nullptr;
+}
+
+Error AttributeLibrarySaver::_save(const Ref<Resource> &p_resource, const String &p_path, uint32_t p_flags)
+{
+	Ref<AttributeLibrary> library = p_resource;
+	ERR_FAIL_COND_V_MSG(library.is_null(), ERR_INVALID_PARAMETER, "Only an AttributeLibrary can be saved as an attribute library.");
+
+	Dictionary buffs = library->get_buffs();
+	Dictionary attribute_sets = library->get_attribute_sets();
+	Array buff_ids = buffs.keys();
+	Array set_ids = attribute_sets.keys();
+
+	/// every buff is written once, the library buffs and the attributes initial buffs share the table
+	BuffTable buff_table;
+
+	LibraryWriter sets;
+	sets.write<uint32_t>(set_ids.size());
+
+	for (int i = 0; i < set_ids.size(); i++) {
+		Ref<AttributeSet> attribute_set = attribute_sets[set_ids[i]];
+		ERR_FAIL_COND_V_MSG(attribute_set.is_null(), ERR_INVALID_DATA, "Attribute library contains a null attribute set.");
+
+		sets.write_string(set_ids[i]);
+
+		if (!write_entry(sets, attribute_set, "AttributeSet")) {
+			continue;
+		}
+
+		TypedArray<AttributeBase> attributes = attribute_set->get_attributes();
+
+		sets.write_string(attribute_set->get_set_name());
+		sets.write<uint32_t>(attributes.size());
+
+		for (int j = 0; j < attributes.size(); j++) {
+			Ref<AttributeBase> attribute = attributes[j];
+			ERR_FAIL_COND_V_MSG(attribute.is_null(), ERR_INVALID_DATA, "Attribute library contains a null attribute.");
+
+			if (!write_entry(sets, attribute, "Attribute")) {
+				continue;
+			}
+
+			TypedArray<AttributeBuff> attribute_buffs = attribute->get_buffs();
+
+			sets.write_string(attribute->get_attribute_name());
+			sets.write<float>(attribute->get_initial_value());
+			sets.write<float>(attribute->get_min_value());
+			sets.write<float>(attribute->get_max_value());
+			sets.write<uint8_t>(attribute->get_replication_mode());
+			sets.write<uint8_t>(attribute->get_aggregation_mode());
+			sets.write_string(attribute->get_min_value_attribute());
+			sets.write_string(attribute->get_max_value_attribute());
+			sets.write_string(attribute->get_rate_attribute());
+
+			PackedFloat32Array scaling_table = Ref<Attribute>(attribute)->get_scaling_table();
+			sets.write<uint32_t>(scaling_table.size());
+
+			for (int k = 0; k < scaling_table.size(); k++) {
+				sets.write<float>(scaling_table[k]);
+			}
+
+			sets.write<uint32_t>(attribute_buffs.size());
+
+			for (int k = 0; k < attribute_buffs.size(); k++) {
+				Ref<AttributeBuff> buff = attribute_buffs[k];
+				ERR_FAIL_COND_V_MSG(buff.is_null(), ERR_INVALID_DATA, "Attribute library contains a null buff.");
+				sets.write<uint32_t>(buff_table.index_of(buff));
+			}
+		}
+	}
+
+	LibraryWriter ids;
+	ids.write<uint32_t>(buff_ids.size());
+
+	for (int i = 0; i < buff_ids.size(); i++) {
+		Ref<AttributeBuff> buff = buffs[buff_ids[i]];
+		ERR_FAIL_COND_V_MSG(buff.is_null(), ERR_INVALID_DATA, "Attribute library contains a null buff.");
+
+		ids.write_string(buff_ids[i]);
+		ids.write<uint32_t>(buff_table.index_of(buff));
+	}
+
+	LibraryWriter writer;
+	writer.write<uint32_t>(MAGIC);
+	writer.write<uint32_t>(VERSION);
+	writer.write<uint32_t>(buff_table.buffs.size());
+
+	for (uint32_t i = 0; i < buff_table.buffs.size(); i++) {
+		write_buff(writer, buff_table.buffs[i]);
+	}
+
+	/// the buff table is read first, the ids and the sets only refer to it
+	PackedByteArray bytes;
+	bytes.resize(writer.data.size() + ids.data.size() + sets.data.size());
+	memcpy(bytes.ptrw(), writer.data.ptr(), writer.data.size());
+	memcpy(bytes.ptrw() + writer.data.size(), ids.data.ptr(), ids.data.size());
+	memcpy(bytes.ptrw() + writer.data.size() + ids.data.size(), sets.data.ptr(), sets.data.size());
+
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(file.is_null(), FileAccess::get_open_error(), "Cannot open the attribute library " + p_path + " for writing.");
+
+	file->store_buffer(bytes);
+
+	return OK;
+}
+
+#pragma endregion
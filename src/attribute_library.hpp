@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*  attribute_library.hpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GGA_ATTRIBUTE_LIBRARY_HPP
+#define GGA_ATTRIBUTE_LIBRARY_HPP
+
+#include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/classes/resource_format_loader.hpp>
+#include <godot_cpp/classes/resource_format_saver.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+using namespace godot;
+
+namespace gga
+{
+	class AttributeBuff;
+	class AttributeSet;
+
+	/// @brief Many attribute sets and buffs, stored by id in a single resource.
+	///
+	/// Saved with the .galib extension, the library is written in a packed binary format which is read at once and
+	/// decoded without parsing any text or loading any sub resource. Attributes and buffs using a script are stored by
+	/// path if they are saved in their own file, embedded otherwise.
+	class AttributeLibrary : public Resource
+	{
+		GDCLASS(AttributeLibrary, Resource);
+
+	protected:
+		/// @brief Bind methods to Godot.
+		static void _bind_methods();
+
+		/// @brief The buffs, by id.
+		Dictionary buffs;
+		/// @brief The attribute sets, by id.
+		Dictionary attribute_sets;
+
+	public:
+		/// @brief Adds a buff, replacing the buff with the same id.
+		/// @param p_id The buff id.
+		/// @param p_buff The buff.
+		void add_buff(const String &p_id, const Ref<AttributeBuff> &p_buff);
+		/// @brief Adds an attribute set, replacing the set with the same id.
+		/// @param p_id The set id.
+		/// @param p_attribute_set The attribute set.
+		void add_attribute_set(const String &p_id, const Ref<AttributeSet> &p_attribute_set);
+		/// @brief Gets a buff by id.
+		/// @param p_id The buff id.
+		/// @return The buff, null if not found.
+		Ref<AttributeBuff> get_buff(const String &p_id) const;
+		/// @brief Gets the buff ids.
+		/// @return The buff ids.
+		PackedStringArray get_buff_ids() const;
+		/// @brief Gets the buffs by id.
+		/// @return The buffs.
+		Dictionary get_buffs() const;
+		/// @brief Gets an attribute set by id.
+		/// @param p_id The set id.
+		/// @return The attribute set, null if not found.
+		Ref<AttributeSet> get_attribute_set(const String &p_id) const;
+		/// @brief Gets the attribute set ids.
+		/// @return The attribute set ids.
+		PackedStringArray get_attribute_set_ids() const;
+		/// @brief Gets the attribute sets by id.
+		/// @return The attribute sets.
+		Dictionary get_attribute_sets() const;
+		/// @brief Sets the buffs by id.
+		/// @param p_value The buffs.
+		void set_buffs(const Dictionary &p_value);
+		/// @brief Sets the attribute sets by id.
+		/// @param p_value The attribute sets.
+		void set_attribute_sets(const Dictionary &p_value);
+	};
+
+	/// @brief Loads the .galib attribute libraries.
+	class AttributeLibraryLoader : public ResourceFormatLoader
+	{
+		GDCLASS(AttributeLibraryLoader, ResourceFormatLoader);
+
+	protected:
+		/// @brief Bind methods to Godot.
+		static void _bind_methods();
+
+	public:
+		PackedStringArray _get_recognized_extensions() const override;
+		String _get_resource_type(const String &p_path) const override;
+		bool _handles_type(const StringName &p_type) const override;
+		Variant _load(const String &p_path, const String &p_original_path, bool p_use_sub_threads, int32_t p_cache_mode) const override;
+	};
+
+	/// @brief Saves the attribute libraries in the .galib packed binary format.
+	class AttributeLibrarySaver : public ResourceFormatSaver
+	{
+		GDCLASS(AttributeLibrarySaver, ResourceFormatSaver);
+
+	protected:
+		/// @brief Bind methods to Godot.
+		static void _bind_methods();
+
+	public:
+		/// @brief The magic number of a library file.
+		static constexpr uint32_t MAGIC = 0x424C4147; // GALB
+		/// @brief The version of the library format.
+		static constexpr uint32_t VERSION = 3;
+
+		PackedStringArray _get_recognized_extensions(const Ref<Resource> &p_resource) const override;
+		bool _recognize(const Ref<Resource> &p_resource) const override;
+		Error _save(const Ref<Resource> &p_resource, const String &p_path, uint32_t p_flags) override;
+	};
+} //namespace gga
+
+#endif
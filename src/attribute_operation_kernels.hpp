@@ -0,0 +1,186 @@
+/**************************************************************************/
+/*  attribute_operation_kernels.hpp                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GGA_ATTRIBUTE_OPERATION_KERNELS_HPP
+#define GGA_ATTRIBUTE_OPERATION_KERNELS_HPP
+
+#include "attribute.hpp"
+
+#include <godot_cpp/core/math.hpp>
+
+using namespace godot;
+
+/// @brief The table of the operation kernels: the operation type, the branch-free kernel and the parameter it uses.
+/// The parameter is computed once from the operation value, when the operation changes.
+/// A new operation type only needs its entry here, the scalar, batch and run kernels are generated from it.
+#define GGA_OPERATION_KERNELS(X)                                                           \
+	X(OP_ADD, p_base + p_parameter, p_value)                                               \
+	X(OP_DIVIDE, p_base * p_parameter, Math::abs(p_value) < 0.0001f ? 0.0f : 1.0f / p_value) \
+	X(OP_MULTIPLY, p_base * p_parameter, p_value)                                          \
+	X(OP_PERCENTAGE, p_base * p_parameter, 1.0f + p_value / 100.0f)                        \
+	X(OP_SUBTRACT, p_base - p_parameter, p_value)
+
+namespace gga
+{
+	/// @brief The kernel of an operation type.
+	template <OperationType T>
+	struct OperationKernel;
+
+#define GGA_DEFINE_OPERATION_KERNEL(m_type, m_apply, m_prepare)                  \
+	template <>                                                                  \
+	struct OperationKernel<m_type>                                               \
+	{                                                                            \
+		static inline float prepare(const float p_value)                         \
+		{                                                                        \
+			return m_prepare;                                                    \
+		}                                                                        \
+		static inline float apply(const float p_base, const float p_parameter)   \
+		{                                                                        \
+			return m_apply;                                                      \
+		}                                                                        \
+	};
+
+	GGA_OPERATION_KERNELS(GGA_DEFINE_OPERATION_KERNEL)
+
+#undef GGA_DEFINE_OPERATION_KERNEL
+
+	/// @brief Applies an operation to every value. The loop has no branch and is vectorized by the compiler.
+	/// @param r_values The values.
+	/// @param p_count The number of values.
+	/// @param p_parameter The operation parameter.
+	template <OperationType T>
+	inline void operate_batch(float *r_values, const uint32_t p_count, const float p_parameter)
+	{
+		for (uint32_t i = 0; i < p_count; i++) {
+			r_values[i] = OperationKernel<T>::apply(r_values[i], p_parameter);
+		}
+	}
+
+	/// @brief Applies a run of operations of the same type to a value, in order.
+	/// @param p_base The value.
+	/// @param p_parameters The parameters of the operations.
+	/// @param p_count The number of operations.
+	/// @return The value after the last operation.
+	template <OperationType T>
+	inline float operate_run(float p_base, const float *p_parameters, const uint32_t p_count)
+	{
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_base = OperationKernel<T>::apply(p_base, p_parameters[i]);
+		}
+
+		return p_base;
+	}
+
+	/// @brief Runtime dispatch to the kernels, done once per value, batch or run.
+	namespace OperationKernels
+	{
+		/// @brief The longest run of operations dispatched at once.
+		static constexpr uint32_t MAX_RUN = 32;
+
+#define GGA_CASE_OPERATION_KERNEL(m_type, m_apply, m_prepare) \
+	case m_type:                                              \
+		return OperationKernel<m_type>::prepare(p_value);
+
+		/// @brief Computes the parameter of an operation.
+		/// @param p_type The operation type.
+		/// @param p_value The operation value.
+		/// @return The parameter, or the value if the type is unknown.
+		inline float prepare(const OperationType p_type, const float p_value)
+		{
+			switch (p_type) {
+				GGA_OPERATION_KERNELS(GGA_CASE_OPERATION_KERNEL)
+				default:
+					return p_value;
+			}
+		}
+
+#undef GGA_CASE_OPERATION_KERNEL
+#define GGA_CASE_OPERATION_KERNEL(m_type, m_apply, m_prepare) \
+	case m_type:                                              \
+		return OperationKernel<m_type>::apply(p_base, p_parameter);
+
+		/// @brief Applies an operation to a value.
+		/// @param p_type The operation type.
+		/// @param p_base The value.
+		/// @param p_parameter The operation parameter.
+		/// @return The result, or the value if the type is unknown.
+		inline float operate(const OperationType p_type, const float p_base, const float p_parameter)
+		{
+			switch (p_type) {
+				GGA_OPERATION_KERNELS(GGA_CASE_OPERATION_KERNEL)
+				default:
+					return p_base;
+			}
+		}
+
+#undef GGA_CASE_OPERATION_KERNEL
+#define GGA_CASE_OPERATION_KERNEL(m_type, m_apply, m_prepare)          \
+	case m_type:                                                   \
+		gga::operate_batch<m_type>(r_values, p_count, p_parameter); \
+		break;
+
+		/// @brief Applies an operation to every value.
+		/// @param p_type The operation type.
+		/// @param r_values The values.
+		/// @param p_count The number of values.
+		/// @param p_parameter The operation parameter.
+		inline void operate_batch(const OperationType p_type, float *r_values, const uint32_t p_count, const float p_parameter)
+		{
+			switch (p_type) {
+				GGA_OPERATION_KERNELS(GGA_CASE_OPERATION_KERNEL)
+				default:
+					break;
+			}
+		}
+
+#undef GGA_CASE_OPERATION_KERNEL
+#define GGA_CASE_OPERATION_KERNEL(m_type, m_apply, m_prepare) \
+	case m_type:                                              \
+		return gga::operate_run<m_type>(p_base, p_parameters, p_count);
+
+		/// @brief Applies a run of operations of the same type to a value, in order.
+		/// @param p_type The operation type.
+		/// @param p_base The value.
+		/// @param p_parameters The parameters of the operations.
+		/// @param p_count The number of operations.
+		/// @return The value after the last operation, or the value if the type is unknown.
+		inline float operate_run(const OperationType p_type, const float p_base, const float *p_parameters, const uint32_t p_count)
+		{
+			switch (p_type) {
+				GGA_OPERATION_KERNELS(GGA_CASE_OPERATION_KERNEL)
+				default:
+					return p_base;
+			}
+		}
+
+#undef GGA_CASE_OPERATION_KERNEL
+	} //namespace OperationKernels
+} //namespace gga
+
+#endif
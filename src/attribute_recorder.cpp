@@ -0,0 +1,762 @@
+/**************************************************************************/
+/*  attribute_recorder.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "attribute_recorder.hpp"
+#include "attribute.hpp"
+#include "attribute_container.hpp"
+#include "buff_pool_queue.hpp"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/core/defs.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+using namespace gga;
+
+namespace
+{
+	/// @brief An attribute restored by a snapshot.
+	struct RecordedAttribute
+	{
+		uint32_t name_id = 0;
+		float value = 0.0f;
+		LocalVector<uint32_t> buff_ids;
+	};
+} //namespace
+
+#pragma region AttributeRecorder
+
+void AttributeRecorder::_bind_methods()
+{
+	ClassDB::bind_method(D_METHOD("attach", "p_container"), &AttributeRecorder::attach);
+	ClassDB::bind_method(D_METHOD("clear"), &AttributeRecorder::clear);
+	ClassDB::bind_method(D_METHOD("detach", "p_container"), &AttributeRecorder::detach);
+	ClassDB::bind_method(D_METHOD("get_event_count"), &AttributeRecorder::get_event_count);
+	ClassDB::bind_method(D_METHOD("get_size"), &AttributeRecorder::get_size);
+	ClassDB::bind_method(D_METHOD("is_recording"), &AttributeRecorder::is_recording);
+	ClassDB::bind_method(D_METHOD("save", "p_path"), &AttributeRecorder::save);
+	ClassDB::bind_method(D_METHOD("set_recording", "p_value"), &AttributeRecorder::set_recording);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "recording"), "set_recording", "is_recording");
+}
+
+AttributeRecorder::~AttributeRecorder()
+{
+	for (uint32_t i = 0; i < containers.size(); i++) {
+		if (containers[i] != nullptr) {
+			containers[i]->recorder = nullptr;
+		}
+	}
+}
+
+uint32_t AttributeRecorder::get_buff_id(const Ref<AttributeBuff> &p_buff)
+{
+	const uint32_t *id = buff_ids.getptr(p_buff.ptr());
+
+	if (id != nullptr) {
+		return *id;
+	}
+
+	/// the buff is kept alive, its address must not be reused by another buff while recording
+	buff_ids.insert(p_buff.ptr(), buffs.size());
+	buffs.push_back(p_buff);
+
+	return buffs.size() - 1;
+}
+
+uint32_t AttributeRecorder::get_name_id(const String &p_name)
+{
+	const uint32_t *id = name_ids.getptr(p_name);
+
+	if (id != nullptr) {
+		return *id;
+	}
+
+	name_ids.insert(p_name, names.size());
+	names.push_back(p_name);
+
+	return names.size() - 1;
+}
+
+void AttributeRecorder::write_event(const EventType p_type, const uint32_t p_container)
+{
+	write<uint8_t>(events, p_type);
+	write<uint16_t>(events, (uint16_t)p_container);
+	event_count++;
+}
+
+uint32_t AttributeRecorder::record_apply_buff(const uint32_t p_container, const Ref<AttributeBuff> &p_buff)
+{
+	if (!recording) {
+		return NONE;
+	}
+
+	write_event(EVENT_APPLY_BUFF, p_container);
+	write<uint32_t>(events, get_buff_id(p_buff));
+
+	return apply_counts[p_container]++;
+}
+
+void AttributeRecorder::record_handle(const uint32_t p_container, const uint32_t p_ordinal, const int64_t p_handle)
+{
+	/// handles are unique per container thanks to their generation, a live handle maps to one ordinal
+	if (p_ordinal != NONE && p_handle != 0) {
+		handle_ordinals[p_container][p_handle] = p_ordinal;
+	}
+}
+
+void AttributeRecorder::record_remove_buff(const uint32_t p_container, const Ref<AttributeBuff> &p_buff)
+{
+	if (recording) {
+		write_event(EVENT_REMOVE_BUFF, p_container);
+		write<uint32_t>(events, get_buff_id(p_buff));
+	}
+}
+
+void AttributeRecorder::record_remove_handle(const uint32_t p_container, const int64_t p_handle)
+{
+	if (!recording) {
+		return;
+	}
+
+	HashMap<int64_t, uint32_t> &ordinals = handle_ordinals[p_container];
+	const uint32_t *found = ordinals.getptr(p_handle);
+	uint32_t ordinal = NONE;
+
+	/// a handle applied while the recording was paused is unknown, its removal replays as a stale handle
+	if (found != nullptr) {
+		ordinal = *found;
+		ordinals.erase(p_handle);
+	}
+
+	write_event(EVENT_REMOVE_HANDLE, p_container);
+	write<uint32_t>(events, ordinal);
+}
+
+void AttributeRecorder::record_remove_tags(const uint32_t p_container, const String &p_attribute_name, const int64_t p_tag_mask)
+{
+	if (recording) {
+		write_event(EVENT_REMOVE_TAGS, p_container);
+		write<uint32_t>(events, p_attribute_name.is_empty() ? NONE : get_name_id(p_attribute_name));
+		write<int64_t>(events, p_tag_mask);
+	}
+}
+
+void AttributeRecorder::record_reset(const uint32_t p_container)
+{
+	if (recording) {
+		write_event(EVENT_RESET, p_container);
+	}
+}
+
+void AttributeRecorder::record_set_level(const uint32_t p_container, const int p_level)
+{
+	if (recording) {
+		write_event(EVENT_SET_LEVEL, p_container);
+		write<int32_t>(events, p_level);
+	}
+}
+
+void AttributeRecorder::record_attribute_buff(const EventType p_type, const uint32_t p_container, const String &p_attribute_name, const Ref<AttributeBuff> &p_buff)
+{
+	if (recording) {
+		write_event(p_type, p_container);
+		write<uint32_t>(events, get_name_id(p_attribute_name));
+		write<uint32_t>(events, get_buff_id(p_buff));
+	}
+}
+
+void AttributeRecorder::record_set_value(const uint32_t p_container, const String &p_attribute_name, const float p_value)
+{
+	if (recording) {
+		write_event(EVENT_SET_VALUE, p_container);
+		write<uint32_t>(events, get_name_id(p_attribute_name));
+		write<float>(events, p_value);
+	}
+}
+
+void AttributeRecorder::record_tick(const uint32_t p_container, const double p_delta)
+{
+	if (recording) {
+		write_event(EVENT_TICK, p_container);
+		write<double>(events, p_delta);
+	}
+}
+
+void AttributeRecorder::record_snapshot(const uint32_t p_container)
+{
+	AttributeContainer *container = containers[p_container];
+
+	if (!recording || container == nullptr) {
+		return;
+	}
+
+	Array _attributes = container->attributes.values();
+
+	write_event(EVENT_SNAPSHOT, p_container);
+	write<int32_t>(events, container->level);
+	write<uint32_t>(events, _attributes.size());
+
+	for (int i = 0; i < _attributes.size(); i++) {
+		Ref<RuntimeAttribute> attribute = _attributes[i];
+		TypedArray<RuntimeBuff> stored = attribute->get_buffs();
+		LocalVector<uint32_t> stored_ids;
+
+		/// the buffs applied through the container are restored with their application below
+		for (int j = 0; j < stored.size(); j++) {
+			Ref<RuntimeBuff> buff = stored[j];
+
+			if (buff->get_handle() == 0) {
+				stored_ids.push_back(get_buff_id(buff->get_buff()));
+			}
+		}
+
+		write<uint32_t>(events, get_name_id(attribute->get_attribute()->get_attribute_name()));
+		write<float>(events, attribute->get_value());
+		write<uint32_t>(events, stored_ids.size());
+
+		for (uint32_t j = 0; j < stored_ids.size(); j++) {
+			write<uint32_t>(events, stored_ids[j]);
+		}
+	}
+
+	LocalVector<Ref<RuntimeBuff>> applied;
+
+	for (uint32_t i = 0; i < container->handle_slots.size(); i++) {
+		const AttributeContainer::BuffHandleSlot &slot = container->handle_slots[i];
+
+		if (slot.used && slot.instances.size() > 0) {
+			applied.push_back(slot.instances[0].buff);
+		}
+	}
+
+	double elapsed = container->buff_pool_queue != nullptr ? container->buff_pool_queue->get_elapsed() : 0.0;
+
+	write<uint32_t>(events, applied.size());
+
+	for (uint32_t i = 0; i < applied.size(); i++) {
+		/// a negative time left restores the application without a timer
+		float time_left = Math::is_zero_approx(applied[i]->get_buff()->get_duration()) ? -1.0f : MAX(0.0f, applied[i]->get_time_left() - (float)elapsed);
+
+		write<uint32_t>(events, get_buff_id(applied[i]->get_buff()));
+		write<float>(events, time_left);
+		handle_ordinals[p_container][applied[i]->get_handle()] = apply_counts[p_container]++;
+	}
+}
+
+int AttributeRecorder::attach(AttributeContainer *p_container)
+{
+	ERR_FAIL_NULL_V_MSG(p_container, -1, "Container cannot be null.");
+	ERR_FAIL_COND_V_MSG(p_container->recorder != nullptr, -1, "Container is already recorded.");
+	ERR_FAIL_COND_V_MSG(containers.size() > UINT16_MAX, -1, "Too many containers recorded.");
+
+	RecordedContainer recorded;
+	Ref<AttributeSet> attribute_set = p_container->get_attribute_set();
+
+	recorded.name = p_container->get_name();
+	recorded.attribute_set_path = attribute_set.is_valid() ? attribute_set->get_path() : String();
+	recorded.update_tier = (uint8_t)p_container->get_update_tier();
+
+	p_container->recorder = this;
+	p_container->recorder_id = containers.size();
+	containers.push_back(p_container);
+	recorded_containers.push_back(recorded);
+	apply_counts.push_back(0);
+	handle_ordinals.push_back(HashMap<int64_t, uint32_t>());
+
+	/// the events apply on top of the state the container had when it was attached
+	record_snapshot(p_container->recorder_id);
+
+	return containers.size() - 1;
+}
+
+void AttributeRecorder::detach(AttributeContainer *p_container)
+{
+	ERR_FAIL_NULL_MSG(p_container, "Container cannot be null.");
+	ERR_FAIL_COND_MSG(p_container->recorder != this, "Container is not recorded by this recorder.");
+
+	containers[p_container->recorder_id] = nullptr;
+	handle_ordinals[p_container->recorder_id].clear();
+	p_container->recorder = nullptr;
+}
+
+void AttributeRecorder::clear()
+{
+	buffs.clear();
+	buff_ids.clear();
+	names.clear();
+	name_ids.clear();
+	events.clear();
+	event_count = 0;
+
+	for (uint32_t i = 0; i < containers.size(); i++) {
+		apply_counts[i] = 0;
+		handle_ordinals[i].clear();
+		record_snapshot(i);
+	}
+}
+
+int AttributeRecorder::get_event_count() const
+{
+	return event_count;
+}
+
+int AttributeRecorder::get_size() const
+{
+	return events.size();
+}
+
+bool AttributeRecorder::is_recording() const
+{
+	return recording;
+}
+
+void AttributeRecorder::set_recording(const bool p_value)
+{
+	if (recording == p_value) {
+		return;
+	}
+
+	recording = p_value;
+
+	/// the traffic missed while paused is unknown, the replay starts again from the current state
+	for (uint32_t i = 0; recording && i < containers.size(); i++) {
+		record_snapshot(i);
+	}
+}
+
+Error AttributeRecorder::save(const String &p_path) const
+{
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(file.is_null(), FileAccess::get_open_error(), "Cannot open the log file for writing.");
+
+	file->store_32(MAGIC);
+	file->store_32(VERSION);
+	file->store_32(recorded_containers.size());
+
+	for (uint32_t i = 0; i < recorded_containers.size(); i++) {
+		file->store_pascal_string(recorded_containers[i].name);
+		file->store_pascal_string(recorded_containers[i].attribute_set_path);
+		file->store_8(recorded_containers[i].update_tier);
+	}
+
+	file->store_32(buffs.size());
+
+	for (uint32_t i = 0; i < buffs.size(); i++) {
+		String path = buffs[i]->get_path();
+
+		/// buffs saved on their own are referenced, the others are embedded with their properties
+		if (!path.is_empty() && path.find("::") < 0) {
+			file->store_8(0);
+			file->store_pascal_string(path);
+		} else {
+			PackedByteArray bytes = UtilityFunctions::var_to_bytes_with_objects(buffs[i]);
+			file->store_8(1);
+			file->store_32(bytes.size());
+			file->store_buffer(bytes);
+		}
+	}
+
+	file->store_32(names.size());
+
+	for (uint32_t i = 0; i < names.size(); i++) {
+		file->store_pascal_string(names[i]);
+	}
+
+	PackedByteArray bytes;
+	bytes.resize(events.size());
+
+	if (events.size() > 0) {
+		memcpy(bytes.ptrw(), events.ptr(), events.size());
+	}
+
+	file->store_32(event_count);
+	file->store_32(bytes.size());
+	file->store_buffer(bytes);
+
+	return OK;
+}
+
+#pragma endregion
+
+#pragma region AttributeReplayer
+
+void AttributeReplayer::_bind_methods()
+{
+	ClassDB::bind_method(D_METHOD("get_container_count"), &AttributeReplayer::get_container_count);
+	ClassDB::bind_method(D_METHOD("get_event_count"), &AttributeReplayer::get_event_count);
+	ClassDB::bind_method(D_METHOD("load", "p_path"), &AttributeReplayer::load);
+	ClassDB::bind_method(D_METHOD("replay", "p_containers"), &AttributeReplayer::replay, DEFVAL(TypedArray<AttributeContainer>()));
+}
+
+Error AttributeReplayer::load(const String &p_path)
+{
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(file.is_null(), FileAccess::get_open_error(), "Cannot open the log file for reading.");
+	ERR_FAIL_COND_V_MSG(file->get_32() != AttributeRecorder::MAGIC, ERR_FILE_UNRECOGNIZED, "Not an attribute log file.");
+	ERR_FAIL_COND_V_MSG(file->get_32() != AttributeRecorder::VERSION, ERR_FILE_UNRECOGNIZED, "Unsupported attribute log version.");
+
+	containers.clear();
+	buffs.clear();
+	names.clear();
+
+	uint32_t count = file->get_32();
+
+	for (uint32_t i = 0; i < count && !file->eof_reached(); i++) {
+		AttributeRecorder::RecordedContainer container;
+		container.name = file->get_pascal_string();
+		container.attribute_set_path = file->get_pascal_string();
+		container.update_tier = file->get_8();
+		containers.push_back(container);
+	}
+
+	count = file->get_32();
+
+	for (uint32_t i = 0; i < count && !file->eof_reached(); i++) {
+		Ref<AttributeBuff> buff;
+
+		if (file->get_8() == 0) {
+			buff = ResourceLoader::get_singleton()->load(file->get_pascal_string());
+		} else {
+			buff = UtilityFunctions::bytes_to_var_with_objects(file->get_buffer(file->get_32()));
+		}
+
+		ERR_FAIL_COND_V_MSG(buff.is_null(), ERR_FILE_CORRUPT, "Cannot restore a recorded buff.");
+		buffs.push_back(buff);
+	}
+
+	count = file->get_32();
+
+	for (uint32_t i = 0; i < count && !file->eof_reached(); i++) {
+		names.push_back(file->get_pascal_string());
+	}
+
+	event_count = file->get_32();
+	uint32_t size = file->get_32();
+	events = file->get_buffer(size);
+
+	ERR_FAIL_COND_V_MSG(events.size() != size, ERR_FILE_CORRUPT, "Attribute log file is truncated.");
+
+	return OK;
+}
+
+int AttributeReplayer::get_container_count() const
+{
+	return containers.size();
+}
+
+int AttributeReplayer::get_event_count() const
+{
+	return event_count;
+}
+
+bool AttributeReplayer::replay_snapshot(AttributeContainer *p_container, int64_t &r_offset, LocalVector<int64_t> &r_handles)
+{
+	int32_t level = 0;
+	uint32_t count = 0;
+	LocalVector<RecordedAttribute> recorded;
+
+	if (!AttributeRecorder::read(events, r_offset, level) || !AttributeRecorder::read(events, r_offset, count)) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		RecordedAttribute attribute;
+		uint32_t buff_count = 0;
+
+		if (!AttributeRecorder::read(events, r_offset, attribute.name_id) || !AttributeRecorder::read(events, r_offset, attribute.value) || !AttributeRecorder::read(events, r_offset, buff_count) || attribute.name_id >= names.size()) {
+			return false;
+		}
+
+		for (uint32_t j = 0; j < buff_count; j++) {
+			uint32_t buff_id = 0;
+
+			if (!AttributeRecorder::read(events, r_offset, buff_id) || buff_id >= buffs.size()) {
+				return false;
+			}
+
+			attribute.buff_ids.push_back(buff_id);
+		}
+
+		recorded.push_back(attribute);
+	}
+
+	if (p_container != nullptr) {
+		/// the level first, so reset seeds the values scaled to it
+		p_container->set_level(level);
+		p_container->reset();
+
+		for (uint32_t i = 0; i < recorded.size(); i++) {
+			Ref<RuntimeAttribute> attribute = p_container->get_attribute_by_name(names[recorded[i].name_id]);
+
+			if (attribute.is_valid()) {
+				attribute->clear_buffs();
+
+				for (uint32_t j = 0; j < recorded[i].buff_ids.size(); j++) {
+					attribute->add_buff(buffs[recorded[i].buff_ids[j]]);
+				}
+			}
+		}
+	}
+
+	if (!AttributeRecorder::read(events, r_offset, count)) {
+		return false;
+	}
+
+	/// the live applications get the next ordinals, in the order the recorder gave them
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t buff_id = 0;
+		float time_left = 0.0f;
+
+		if (!AttributeRecorder::read(events, r_offset, buff_id) || !AttributeRecorder::read(events, r_offset, time_left) || buff_id >= buffs.size()) {
+			return false;
+		}
+
+		r_handles.push_back(p_container != nullptr ? p_container->apply_buff_internal(buffs[buff_id], time_left) : 0);
+	}
+
+	/// the values are written last, the buffs above must not move them
+	for (uint32_t i = 0; p_container != nullptr && i < recorded.size(); i++) {
+		Ref<RuntimeAttribute> attribute = p_container->get_attribute_by_name(names[recorded[i].name_id]);
+
+		if (attribute.is_valid()) {
+			attribute->set_value(recorded[i].value);
+		}
+	}
+
+	return true;
+}
+
+Dictionary AttributeReplayer::replay(const TypedArray<AttributeContainer> &p_containers)
+{
+	Dictionary report = Dictionary();
+	LocalVector<AttributeContainer *> targets;
+	bool owned = p_containers.size() == 0;
+
+	if (owned) {
+		for (uint32_t i = 0; i < containers.size(); i++) {
+			Ref<AttributeSet> attribute_set;
+
+			if (!containers[i].attribute_set_path.is_empty()) {
+				attribute_set = ResourceLoader::get_singleton()->load(containers[i].attribute_set_path);
+			}
+
+			if (attribute_set.is_null()) {
+				/// the events of a container whose attribute set was not saved are skipped
+				WARN_PRINT("Cannot load the attribute set of the recorded container " + containers[i].name + ".");
+				targets.push_back(nullptr);
+				continue;
+			}
+
+			AttributeContainer *container = memnew(AttributeContainer);
+
+			container->set_name(containers[i].name);
+			container->set_attribute_set(attribute_set);
+			container->set_update_tier((UpdateTier)containers[i].update_tier);
+			/// the containers are never added to a tree, the replay drives them
+			container->_ready();
+			targets.push_back(container);
+		}
+	} else {
+		ERR_FAIL_COND_V_MSG((uint32_t)p_containers.size() < containers.size(), report, "Not enough containers to replay the log.");
+
+		for (int i = 0; i < p_containers.size(); i++) {
+			targets.push_back(Object::cast_to<AttributeContainer>(p_containers[i]));
+		}
+	}
+
+	/// the time spent per event type, indexed by EventType
+	uint64_t usec[AttributeRecorder::EVENT_MAX] = {};
+	uint32_t counts[AttributeRecorder::EVENT_MAX] = {};
+	/// the handles returned by the replayed apply events of each container, indexed by apply ordinal
+	LocalVector<LocalVector<int64_t>> applied_handles;
+	int64_t offset = 0;
+	uint64_t start = Time::get_singleton()->get_ticks_usec();
+
+	applied_handles.resize(targets.size());
+
+	while (offset < events.size()) {
+		uint8_t type = 0;
+		uint16_t container_id = 0;
+
+		if (!AttributeRecorder::read(events, offset, type) || !AttributeRecorder::read(events, offset, container_id) || container_id >= targets.size() || type >= AttributeRecorder::EVENT_MAX) {
+			ERR_PRINT("Attribute log is corrupt, the replay stopped.");
+			break;
+		}
+
+		AttributeContainer *container = targets[container_id];
+		LocalVector<int64_t> &handles = applied_handles[container_id];
+		uint64_t event_start = Time::get_singleton()->get_ticks_usec();
+		bool valid = true;
+
+		switch (type) {
+			case AttributeRecorder::EVENT_TICK: {
+				double delta = 0.0;
+				valid = AttributeRecorder::read(events, offset, delta);
+
+				if (valid && container != nullptr) {
+					container->_physics_process(delta);
+				}
+			} break;
+			case AttributeRecorder::EVENT_APPLY_BUFF: {
+				uint32_t buff_id = 0;
+				valid = AttributeRecorder::read(events, offset, buff_id) && buff_id < buffs.size();
+
+				if (valid) {
+					/// the ordinals are counted even for a skipped container, so the next ones stay aligned
+					handles.push_back(container != nullptr ? container->apply_buff(buffs[buff_id]) : 0);
+				}
+			} break;
+			case AttributeRecorder::EVENT_REMOVE_BUFF: {
+				uint32_t buff_id = 0;
+				valid = AttributeRecorder::read(events, offset, buff_id) && buff_id < buffs.size();
+
+				if (valid && container != nullptr) {
+					container->remove_buff(buffs[buff_id]);
+				}
+			} break;
+			case AttributeRecorder::EVENT_REMOVE_HANDLE: {
+				uint32_t ordinal = 0;
+				valid = AttributeRecorder::read(events, offset, ordinal);
+
+				/// a handle unknown to the recorder is stale, removing it does nothing
+				if (valid && container != nullptr && ordinal < handles.size() && handles[ordinal] != 0) {
+					container->remove_buff_by_handle(handles[ordinal]);
+				}
+			} break;
+			case AttributeRecorder::EVENT_SET_VALUE: {
+				uint32_t name_id = 0;
+				float value = 0.0f;
+				valid = AttributeRecorder::read(events, offset, name_id) && AttributeRecorder::read(events, offset, value) && name_id < names.size();
+
+				if (valid && container != nullptr) {
+					Ref<RuntimeAttribute> attribute = container->get_attribute_by_name(names[name_id]);
+
+					if (attribute.is_valid()) {
+						attribute->set_value(value);
+					}
+				}
+			} break;
+			case AttributeRecorder::EVENT_REMOVE_TAGS: {
+				uint32_t name_id = 0;
+				int64_t tag_mask = 0;
+				valid = AttributeRecorder::read(events, offset, name_id) && AttributeRecorder::read(events, offset, tag_mask) && (name_id == AttributeRecorder::NONE || name_id < names.size());
+
+				if (valid && container != nullptr) {
+					if (name_id == AttributeRecorder::NONE) {
+						container->remove_buffs_with_tags(tag_mask);
+					} else {
+						Ref<RuntimeAttribute> attribute = container->get_attribute_by_name(names[name_id]);
+
+						if (attribute.is_valid()) {
+							attribute->remove_buffs_with_tags(tag_mask);
+						}
+					}
+				}
+			} break;
+			case AttributeRecorder::EVENT_RESET: {
+				if (container != nullptr) {
+					container->reset();
+				}
+			} break;
+			case AttributeRecorder::EVENT_SET_LEVEL: {
+				int32_t level = 0;
+				valid = AttributeRecorder::read(events, offset, level);
+
+				if (valid && container != nullptr) {
+					container->set_level(level);
+				}
+			} break;
+			case AttributeRecorder::EVENT_ADD_ATTRIBUTE_BUFF:
+			case AttributeRecorder::EVENT_REMOVE_ATTRIBUTE_BUFF:
+			case AttributeRecorder::EVENT_REMOVE_ATTRIBUTE_BUFFS: {
+				uint32_t name_id = 0;
+				uint32_t buff_id = 0;
+				valid = AttributeRecorder::read(events, offset, name_id) && AttributeRecorder::read(events, offset, buff_id) && name_id < names.size() && buff_id < buffs.size();
+
+				Ref<RuntimeAttribute> attribute = valid && container != nullptr ? container->get_attribute_by_name(names[name_id]) : Ref<RuntimeAttribute>();
+
+				if (attribute.is_null()) {
+					break;
+				}
+
+				if (type == AttributeRecorder::EVENT_ADD_ATTRIBUTE_BUFF) {
+					attribute->add_buff(buffs[buff_id]);
+				} else if (type == AttributeRecorder::EVENT_REMOVE_ATTRIBUTE_BUFF) {
+					attribute->remove_buff(buffs[buff_id]);
+				} else {
+					TypedArray<AttributeBuff> removed;
+					removed.push_back(buffs[buff_id]);
+					attribute->remove_buffs(removed);
+				}
+			} break;
+			case AttributeRecorder::EVENT_SNAPSHOT: {
+				valid = replay_snapshot(container, offset, handles);
+			} break;
+		}
+
+		if (!valid) {
+			ERR_PRINT("Attribute log is corrupt, the replay stopped.");
+			break;
+		}
+
+		usec[type] += Time::get_singleton()->get_ticks_usec() - event_start;
+		counts[type]++;
+	}
+
+	uint64_t total = Time::get_singleton()->get_ticks_usec() - start;
+
+	if (owned) {
+		for (uint32_t i = 0; i < targets.size(); i++) {
+			if (targets[i] != nullptr) {
+				memdelete(targets[i]);
+			}
+		}
+	}
+
+	uint32_t event_total = 0;
+
+	for (int i = 0; i < AttributeRecorder::EVENT_MAX; i++) {
+		event_total += counts[i];
+	}
+
+	report["events"] = event_total;
+	report["ticks"] = counts[AttributeRecorder::EVENT_TICK];
+	report["total_usec"] = total;
+	report["tick_usec"] = usec[AttributeRecorder::EVENT_TICK];
+	report["apply_buff_usec"] = usec[AttributeRecorder::EVENT_APPLY_BUFF] + usec[AttributeRecorder::EVENT_ADD_ATTRIBUTE_BUFF];
+	report["remove_buff_usec"] = usec[AttributeRecorder::EVENT_REMOVE_BUFF] + usec[AttributeRecorder::EVENT_REMOVE_HANDLE] + usec[AttributeRecorder::EVENT_REMOVE_TAGS] + usec[AttributeRecorder::EVENT_REMOVE_ATTRIBUTE_BUFF] + usec[AttributeRecorder::EVENT_REMOVE_ATTRIBUTE_BUFFS];
+	report["set_value_usec"] = usec[AttributeRecorder::EVENT_SET_VALUE];
+	report["state_usec"] = usec[AttributeRecorder::EVENT_RESET] + usec[AttributeRecorder::EVENT_SET_LEVEL] + usec[AttributeRecorder::EVENT_SNAPSHOT];
+
+	return report;
+}
+
+#pragma endregion
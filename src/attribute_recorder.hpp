@@ -0,0 +1,269 @@
+/**************************************************************************/
+/*  attribute_recorder.hpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GGA_ATTRIBUTE_RECORDER_HPP
+#define GGA_ATTRIBUTE_RECORDER_HPP
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
+
+#include <cstring>
+
+using namespace godot;
+
+namespace gga
+{
+	class AttributeBuff;
+	class AttributeContainer;
+
+	/// @brief Records the buff traffic of attribute containers into a compact binary log.
+	///
+	/// The state of each container is saved when it is attached, then every apply_buff, remove_buff, remove_buff_by_handle,
+	/// remove_buffs_with_tags, reset, set_level and physics tick of the attached containers is appended to the log, in
+	/// the order they happen, along with the add_buff, remove_buff, remove_buffs, remove_buffs_with_tags and set_value
+	/// calls made directly on their runtime attributes. Buffs removed because they expired are not recorded, the replay
+	/// expires them again. Handles are recorded as the ordinal of the apply event that returned them, the replay maps
+	/// them to the handles it gets. The log is replayed by AttributeReplayer.
+	class AttributeRecorder : public RefCounted
+	{
+		GDCLASS(AttributeRecorder, RefCounted);
+
+		friend class AttributeContainer;
+		friend class RuntimeAttribute;
+
+	public:
+		/// @brief The magic number of a log file.
+		static constexpr uint32_t MAGIC = 0x52414747; // GGAR
+		/// @brief The version of the log format.
+		static constexpr uint32_t VERSION = 2;
+		/// @brief An absent name or apply ordinal in the log.
+		static constexpr uint32_t NONE = UINT32_MAX;
+
+		enum EventType : uint8_t
+		{
+			EVENT_TICK = 0,
+			EVENT_APPLY_BUFF = 1,
+			EVENT_REMOVE_BUFF = 2,
+			EVENT_REMOVE_HANDLE = 3,
+			EVENT_SET_VALUE = 4,
+			EVENT_REMOVE_TAGS = 5,
+			EVENT_RESET = 6,
+			EVENT_SET_LEVEL = 7,
+			EVENT_ADD_ATTRIBUTE_BUFF = 8,
+			EVENT_REMOVE_ATTRIBUTE_BUFF = 9,
+			EVENT_REMOVE_ATTRIBUTE_BUFFS = 10,
+			EVENT_SNAPSHOT = 11,
+			EVENT_MAX = 12,
+		};
+
+		/// @brief A recorded container.
+		struct RecordedContainer
+		{
+			String name;
+			String attribute_set_path;
+			uint8_t update_tier = 0;
+		};
+
+		/// @brief Appends a value to a byte buffer.
+		/// @param r_buffer The buffer.
+		/// @param p_value The value.
+		template <typename T>
+		static void write(LocalVector<uint8_t> &r_buffer, const T p_value)
+		{
+			uint32_t offset = r_buffer.size();
+			r_buffer.resize(offset + sizeof(T));
+			memcpy(r_buffer.ptr() + offset, &p_value, sizeof(T));
+		}
+
+		/// @brief Reads a value from a byte buffer.
+		/// @param p_buffer The buffer.
+		/// @param r_offset The read offset, advanced past the value.
+		/// @param r_value The value.
+		/// @return False if the buffer is too short.
+		template <typename T>
+		static bool read(const PackedByteArray &p_buffer, int64_t &r_offset, T &r_value)
+		{
+			if (r_offset + (int64_t)sizeof(T) > p_buffer.size()) {
+				return false;
+			}
+
+			memcpy(&r_value, p_buffer.ptr() + r_offset, sizeof(T));
+			r_offset += sizeof(T);
+
+			return true;
+		}
+
+	protected:
+		/// @brief Bind methods to Godot.
+		static void _bind_methods();
+
+		/// @brief The attached containers, their index in this list is their id in the log. Detached containers are null.
+		LocalVector<AttributeContainer *> containers;
+		/// @brief The attached containers as they were when attached.
+		LocalVector<RecordedContainer> recorded_containers;
+		/// @brief The recorded buffs, their index in this list is their id in the log.
+		LocalVector<Ref<AttributeBuff>> buffs;
+		/// @brief The id of each recorded buff.
+		HashMap<const AttributeBuff *, uint32_t> buff_ids;
+		/// @brief The number of apply events recorded for each container, the ordinal of the next one.
+		LocalVector<uint32_t> apply_counts;
+		/// @brief The apply ordinal of each live handle, for each container.
+		LocalVector<HashMap<int64_t, uint32_t>> handle_ordinals;
+		/// @brief The recorded attribute names, their index in this list is their id in the log.
+		LocalVector<String> names;
+		/// @brief The id of each recorded attribute name.
+		HashMap<String, uint32_t> name_ids;
+		/// @brief The recorded events.
+		LocalVector<uint8_t> events;
+		/// @brief The number of recorded events.
+		uint32_t event_count = 0;
+		/// @brief Whether the recorder is recording.
+		bool recording = true;
+
+		/// @brief Returns the id of a buff, recording it the first time.
+		/// @param p_buff The buff.
+		/// @return The buff id.
+		uint32_t get_buff_id(const Ref<AttributeBuff> &p_buff);
+		/// @brief Returns the id of an attribute name, recording it the first time.
+		/// @param p_name The attribute name.
+		/// @return The name id.
+		uint32_t get_name_id(const String &p_name);
+		/// @brief Appends the header of an event.
+		/// @param p_type The event type.
+		/// @param p_container The container id.
+		void write_event(const EventType p_type, const uint32_t p_container);
+		/// @brief Records a buff application.
+		/// @return The apply ordinal of the event, NONE if nothing was recorded.
+		uint32_t record_apply_buff(const uint32_t p_container, const Ref<AttributeBuff> &p_buff);
+		/// @brief Records the handle returned by a recorded buff application.
+		/// @param p_container The container id.
+		/// @param p_ordinal The apply ordinal returned by record_apply_buff.
+		/// @param p_handle The handle.
+		void record_handle(const uint32_t p_container, const uint32_t p_ordinal, const int64_t p_handle);
+		/// @brief Records a buff removal.
+		void record_remove_buff(const uint32_t p_container, const Ref<AttributeBuff> &p_buff);
+		/// @brief Records a buff removal by handle, the handle is written as its apply ordinal.
+		void record_remove_handle(const uint32_t p_container, const int64_t p_handle);
+		/// @brief Records a removal of the buffs matching a tag mask, from an attribute or from the whole container.
+		/// @param p_attribute_name The attribute name, empty for the whole container.
+		void record_remove_tags(const uint32_t p_container, const String &p_attribute_name, const int64_t p_tag_mask);
+		/// @brief Records a reset of the container.
+		void record_reset(const uint32_t p_container);
+		/// @brief Records a level change of the container.
+		void record_set_level(const uint32_t p_container, const int p_level);
+		/// @brief Records a buff added to or removed from an attribute directly.
+		/// @param p_type EVENT_ADD_ATTRIBUTE_BUFF, EVENT_REMOVE_ATTRIBUTE_BUFF or EVENT_REMOVE_ATTRIBUTE_BUFFS.
+		void record_attribute_buff(const EventType p_type, const uint32_t p_container, const String &p_attribute_name, const Ref<AttributeBuff> &p_buff);
+		/// @brief Records an attribute value change.
+		void record_set_value(const uint32_t p_container, const String &p_attribute_name, const float p_value);
+		/// @brief Records a physics tick.
+		void record_tick(const uint32_t p_container, const double p_delta);
+		/// @brief Records the level, values, stored buffs and live applications of a container, the replay starts from them.
+		/// @param p_container The container id.
+		void record_snapshot(const uint32_t p_container);
+
+	public:
+		/// @brief Destructor, detaches the containers.
+		~AttributeRecorder();
+		/// @brief Starts recording a container.
+		/// @param p_container The container.
+		/// @return The container id in the log, -1 on failure.
+		int attach(AttributeContainer *p_container);
+		/// @brief Stops recording a container. Its id is not reused.
+		/// @param p_container The container.
+		void detach(AttributeContainer *p_container);
+		/// @brief Discards the recorded events, the attached containers keep their ids and their state is recorded again.
+		void clear();
+		/// @brief Returns the number of recorded events.
+		/// @return The number of recorded events.
+		int get_event_count() const;
+		/// @brief Returns the size of the recorded events.
+		/// @return The size in bytes.
+		int get_size() const;
+		/// @brief Returns whether the recorder is recording.
+		/// @return True if the recorder is recording.
+		bool is_recording() const;
+		/// @brief Pauses or resumes the recording. The state of the attached containers is recorded when the recording resumes.
+		/// @param p_value True to record.
+		void set_recording(const bool p_value);
+		/// @brief Writes the log to a file.
+		/// @param p_path The file path.
+		/// @return OK, or the error of the file opening.
+		Error save(const String &p_path) const;
+	};
+
+	/// @brief Replays a log written by AttributeRecorder and reports its timing.
+	class AttributeReplayer : public RefCounted
+	{
+		GDCLASS(AttributeReplayer, RefCounted);
+
+	protected:
+		/// @brief Bind methods to Godot.
+		static void _bind_methods();
+
+		/// @brief The recorded containers.
+		LocalVector<AttributeRecorder::RecordedContainer> containers;
+		/// @brief The recorded buffs.
+		LocalVector<Ref<AttributeBuff>> buffs;
+		/// @brief The recorded attribute names.
+		LocalVector<String> names;
+		/// @brief The recorded events.
+		PackedByteArray events;
+		/// @brief The number of recorded events.
+		uint32_t event_count = 0;
+
+		/// @brief Restores a recorded snapshot on a container.
+		/// @param p_container The container, null to skip the snapshot.
+		/// @param r_offset The read offset, advanced past the snapshot.
+		/// @param r_handles The handles of the replayed apply events of the container, the restored applications are appended.
+		/// @return False if the log is corrupt.
+		bool replay_snapshot(AttributeContainer *p_container, int64_t &r_offset, LocalVector<int64_t> &r_handles);
+
+	public:
+		/// @brief Loads a log.
+		/// @param p_path The file path.
+		/// @return OK, or the error of the loading.
+		Error load(const String &p_path);
+		/// @brief Returns the number of containers of the loaded log.
+		/// @return The number of containers.
+		int get_container_count() const;
+		/// @brief Returns the number of events of the loaded log.
+		/// @return The number of events.
+		int get_event_count() const;
+		/// @brief Drives the loaded traffic against containers, calling their _physics_process for each tick.
+		/// @param p_containers The containers, by log id. If empty, fresh containers are created from the recorded attribute sets and freed afterwards.
+		/// @return The timing report, empty on failure.
+		Dictionary replay(const TypedArray<AttributeContainer> &p_containers = TypedArray<AttributeContainer>());
+	};
+} //namespace gga
+
+#endif
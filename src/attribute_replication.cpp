@@ -0,0 +1,296 @@
+/**************************************************************************/
+/*  attribute_replication.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "attribute_replication.hpp"
+
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/core/math.hpp>
+
+#include <cstring>
+
+using namespace gga;
+
+namespace
+{
+	/// @brief Appends an unsigned varint to the buffer.
+	void write_varuint(LocalVector<uint8_t> &r_buffer, uint64_t p_value)
+	{
+		while (p_value >= 0x80) {
+			r_buffer.push_back((uint8_t)(p_value | 0x80));
+			p_value >>= 7;
+		}
+
+		r_buffer.push_back((uint8_t)p_value);
+	}
+
+	/// @brief Appends a zigzag encoded signed varint to the buffer.
+	void write_varint(LocalVector<uint8_t> &r_buffer, const int64_t p_value)
+	{
+		write_varuint(r_buffer, ((uint64_t)p_value << 1) ^ (uint64_t)(p_value >> 63));
+	}
+
+	/// @brief Reads an unsigned varint, advancing the offset. Returns false if the buffer ends too early.
+	bool read_varuint(const uint8_t *p_buffer, const int64_t p_size, int64_t &r_offset, uint64_t &r_value)
+	{
+		r_value = 0;
+
+		for (int shift = 0; shift < 64; shift += 7) {
+			if (r_offset >= p_size) {
+				return false;
+			}
+
+			uint8_t byte = p_buffer[r_offset++];
+			r_value |= (uint64_t)(byte & 0x7F) << shift;
+
+			if ((byte & 0x80) == 0) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/// @brief Reads a zigzag encoded signed varint, advancing the offset.
+	bool read_varint(const uint8_t *p_buffer, const int64_t p_size, int64_t &r_offset, int64_t &r_value)
+	{
+		uint64_t raw;
+
+		if (!read_varuint(p_buffer, p_size, r_offset, raw)) {
+			return false;
+		}
+
+		r_value = (int64_t)(raw >> 1) ^ -(int64_t)(raw & 1);
+		return true;
+	}
+
+	/// @brief Copies a local buffer into a PackedByteArray.
+	PackedByteArray to_packed(const LocalVector<uint8_t> &p_buffer)
+	{
+		PackedByteArray packed;
+		packed.resize(p_buffer.size());
+
+		if (p_buffer.size() > 0) {
+			memcpy(packed.ptrw(), p_buffer.ptr(), p_buffer.size());
+		}
+
+		return packed;
+	}
+} //namespace
+
+int64_t AttributeReplication::quantize(const float p_value, const float p_precision)
+{
+	double quantized = Math::round((double)p_value / (double)p_precision);
+
+	/// casting NaN or a value out of the int64 range is undefined, such values are clamped
+	if (Math::is_nan(quantized)) {
+		return 0;
+	}
+
+	return (int64_t)Math::clamp(quantized, -MAX_QUANTIZED_VALUE, MAX_QUANTIZED_VALUE);
+}
+
+float AttributeReplication::dequantize(const int64_t p_quantized, const float p_precision)
+{
+	return (float)((double)p_quantized * (double)p_precision);
+}
+
+bool AttributeReplication::read_stream(const PackedByteArray &p_packet, int32_t &r_stream)
+{
+	const uint8_t *data = p_packet.ptr();
+	const int64_t size = p_packet.size();
+	int64_t offset = 1;
+	int64_t stream;
+
+	ERR_FAIL_COND_V_MSG(size < 1 || data[0] != FORMAT_VERSION, false, "Unknown attribute replication packet format.");
+	ERR_FAIL_COND_V_MSG(!read_varint(data, size, offset, stream) || stream < INT32_MIN || stream > INT32_MAX, false, "Malformed attribute replication packet.");
+
+	r_stream = (int32_t)stream;
+	return true;
+}
+
+PackedByteArray AttributeReplication::get_dirty_mask(const LocalVector<float> &p_values, const LocalVector<uint8_t> &p_visible, const float p_precision) const
+{
+	PackedByteArray mask;
+	mask.resize((p_values.size() + 7) / 8);
+
+	uint8_t *mask_ptr = mask.ptrw();
+
+	for (uint32_t i = 0; i < (uint32_t)mask.size(); i++) {
+		mask_ptr[i] = 0;
+	}
+
+	for (uint32_t i = 0; i < p_values.size(); i++) {
+		if (!p_visible[i]) {
+			continue;
+		}
+
+		if (i >= baseline.size() || baseline[i] != quantize(p_values[i], p_precision)) {
+			mask_ptr[i / 8] |= 1 << (i % 8);
+		}
+	}
+
+	return mask;
+}
+
+PackedByteArray AttributeReplication::encode(const LocalVector<float> &p_values, const LocalVector<uint8_t> &p_visible, const float p_precision, const bool p_full, const int32_t p_stream)
+{
+	Snapshot snapshot;
+	snapshot.sequence = next_sequence++;
+	snapshot.values.resize(p_values.size());
+
+	for (uint32_t i = 0; i < p_values.size(); i++) {
+		/// hidden values are never sent, so the receiver does not know them
+		snapshot.values[i] = p_visible[i] ? quantize(p_values[i], p_precision) : UNKNOWN_VALUE;
+	}
+
+	uint32_t mask_size = (p_values.size() + 7) / 8;
+	LocalVector<uint8_t> buffer;
+
+	buffer.reserve(mask_size + 13 + p_values.size() * 2);
+	buffer.push_back(FORMAT_VERSION);
+	write_varint(buffer, p_stream);
+	write_varuint(buffer, snapshot.sequence);
+	write_varuint(buffer, p_values.size());
+
+	uint32_t mask_offset = buffer.size();
+	buffer.resize(mask_offset + mask_size);
+
+	for (uint32_t i = 0; i < mask_size; i++) {
+		buffer[mask_offset + i] = 0;
+	}
+
+	for (uint32_t i = 0; i < snapshot.values.size(); i++) {
+		if (!p_visible[i]) {
+			continue;
+		}
+
+		if (p_full || i >= baseline.size() || baseline[i] != snapshot.values[i]) {
+			buffer[mask_offset + i / 8] |= 1 << (i % 8);
+			write_varint(buffer, snapshot.values[i]);
+		}
+	}
+
+	if (pending.size() >= MAX_PENDING_SNAPSHOTS) {
+		pending.remove_at(0);
+	}
+
+	pending.push_back(snapshot);
+
+	return to_packed(buffer);
+}
+
+bool AttributeReplication::acknowledge(const uint32_t p_sequence)
+{
+	for (uint32_t i = 0; i < pending.size(); i++) {
+		if (pending[i].sequence == p_sequence) {
+			baseline = pending[i].values;
+
+			/// older snapshots can not be acknowledged anymore, the baseline moved past them
+			for (uint32_t j = 0; j <= i; j++) {
+				pending.remove_at(0);
+			}
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool AttributeReplication::decode(const PackedByteArray &p_packet, LocalVector<float> &r_values, const float p_precision, LocalVector<uint32_t> &r_changed)
+{
+	const uint8_t *data = p_packet.ptr();
+	const int64_t size = p_packet.size();
+	int64_t offset = 0;
+	int64_t stream;
+	uint64_t sequence;
+	uint64_t count;
+
+	ERR_FAIL_COND_V_MSG(size < 1 || data[0] != FORMAT_VERSION, false, "Unknown attribute replication packet format.");
+
+	offset++;
+
+	ERR_FAIL_COND_V_MSG(!read_varint(data, size, offset, stream), false, "Malformed attribute replication packet.");
+
+	ERR_FAIL_COND_V_MSG(!read_varuint(data, size, offset, sequence), false, "Malformed attribute replication packet.");
+	ERR_FAIL_COND_V_MSG(!read_varuint(data, size, offset, count), false, "Malformed attribute replication packet.");
+	ERR_FAIL_COND_V_MSG(count != r_values.size(), false, "Attribute replication packet does not match the container attributes.");
+
+	/// sequences wrap around, so they are compared using serial number arithmetic
+	if (has_received && (int32_t)((uint32_t)sequence - last_received_sequence) <= 0) {
+		return false;
+	}
+
+	uint32_t mask_size = (count + 7) / 8;
+	const int64_t mask_offset = offset;
+
+	ERR_FAIL_COND_V_MSG(offset + mask_size > size, false, "Malformed attribute replication packet.");
+
+	offset += mask_size;
+
+	/// values are decoded first and written afterwards, a truncated packet must not be applied partially
+	LocalVector<uint32_t> indices;
+	LocalVector<float> values;
+
+	for (uint32_t i = 0; i < count; i++) {
+		if ((data[mask_offset + i / 8] & (1 << (i % 8))) == 0) {
+			continue;
+		}
+
+		int64_t quantized;
+		ERR_FAIL_COND_V_MSG(!read_varint(data, size, offset, quantized), false, "Malformed attribute replication packet.");
+
+		indices.push_back(i);
+		values.push_back(dequantize(quantized, p_precision));
+	}
+
+	for (uint32_t i = 0; i < indices.size(); i++) {
+		r_values[indices[i]] = values[i];
+		r_changed.push_back(indices[i]);
+	}
+
+	has_received = true;
+	last_received_sequence = (uint32_t)sequence;
+
+	return true;
+}
+
+uint32_t AttributeReplication::get_last_received_sequence() const
+{
+	return last_received_sequence;
+}
+
+void AttributeReplication::reset()
+{
+	baseline.clear();
+	pending.clear();
+	next_sequence = 1;
+	last_received_sequence = 0;
+	has_received = false;
+}
@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*  attribute_replication.hpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GGA_ATTRIBUTE_REPLICATION_HPP
+#define GGA_ATTRIBUTE_REPLICATION_HPP
+
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+
+#include <cstdint>
+
+using namespace godot;
+
+namespace gga
+{
+	/// @brief Replication state of an AttributeContainer.
+	///
+	/// Values are quantized with the container precision and compared against the last state acknowledged by the receiver.
+	/// Only the attributes whose quantized value differs from that baseline are written into a delta packet, so the
+	/// bandwidth is proportional to what changed. Unacknowledged changes are sent again until an ack arrives.
+	/// Each stream has its own sequence, so the receiver keeps one state per stream.
+	///
+	/// Packet layout:
+	/// - u8 format version
+	/// - zigzag varint stream, the peer the packet was encoded for or 0 for a broadcast
+	/// - varuint sequence
+	/// - varuint attribute count
+	/// - dirty bitmask, one bit per attribute
+	/// - zigzag varint quantized value for each dirty attribute
+	class AttributeReplication
+	{
+	public:
+		/// @brief Packet format version.
+		static constexpr uint8_t FORMAT_VERSION = 2;
+		/// @brief Maximum number of unacknowledged snapshots kept around.
+		static constexpr uint32_t MAX_PENDING_SNAPSHOTS = 32;
+		/// @brief Marks a value the receiver does not know.
+		static constexpr int64_t UNKNOWN_VALUE = INT64_MIN;
+		/// @brief The largest quantized magnitude, exactly representable as a double and far from UNKNOWN_VALUE.
+		static constexpr double MAX_QUANTIZED_VALUE = 4503599627370496.0;
+
+		/// @brief Quantizes a value with the given precision. NaN is quantized to 0 and infinities to the largest quantized value.
+		/// @param p_value The value to quantize.
+		/// @param p_precision The precision.
+		/// @return The quantized value.
+		static int64_t quantize(const float p_value, const float p_precision);
+		/// @brief Restores a quantized value.
+		/// @param p_quantized The quantized value.
+		/// @param p_precision The precision.
+		/// @return The restored value.
+		static float dequantize(const int64_t p_quantized, const float p_precision);
+		/// @brief Reads the stream a packet was encoded for.
+		/// @param p_packet The packet.
+		/// @param r_stream The stream, 0 for a broadcast.
+		/// @return True if the packet header is valid, false otherwise.
+		static bool read_stream(const PackedByteArray &p_packet, int32_t &r_stream);
+
+		/// @brief Builds the dirty bitmask of the given values against the acknowledged baseline.
+		/// @param p_values The current values.
+		/// @param p_visible For each value, 0 if the receiver must not see it.
+		/// @param p_precision The quantization precision.
+		/// @return The dirty bitmask, one bit per value.
+		PackedByteArray get_dirty_mask(const LocalVector<float> &p_values, const LocalVector<uint8_t> &p_visible, const float p_precision) const;
+		/// @brief Encodes a delta packet of the given values against the acknowledged baseline. Values that are not visible are never written.
+		/// @param p_values The current values.
+		/// @param p_visible For each value, 0 if the receiver must not see it.
+		/// @param p_precision The quantization precision.
+		/// @param p_full If true, every visible value is written regardless of the baseline.
+		/// @param p_stream The stream written in the packet, the peer it is encoded for or 0 for a broadcast.
+		/// @return The encoded packet.
+		PackedByteArray encode(const LocalVector<float> &p_values, const LocalVector<uint8_t> &p_visible, const float p_precision, const bool p_full, const int32_t p_stream);
+		/// @brief Acknowledges a sequence, making its snapshot the new baseline.
+		/// @param p_sequence The acknowledged sequence.
+		/// @return True if the sequence was pending, false otherwise.
+		bool acknowledge(const uint32_t p_sequence);
+		/// @brief Decodes a delta packet into the given values, skipping stale packets.
+		/// @param p_packet The packet to decode.
+		/// @param r_values The values to update, must have the same size of the encoder values.
+		/// @param p_precision The quantization precision.
+		/// @param r_changed The indices of the values that were written.
+		/// @return True if the packet was applied, false if it is stale or malformed.
+		bool decode(const PackedByteArray &p_packet, LocalVector<float> &r_values, const float p_precision, LocalVector<uint32_t> &r_changed);
+		/// @brief Returns the sequence of the last decoded packet.
+		/// @return The last received sequence.
+		uint32_t get_last_received_sequence() const;
+		/// @brief Forgets the baseline, pending snapshots and the last received sequence.
+		void reset();
+
+	protected:
+		/// @brief A snapshot of quantized values sent with a sequence.
+		struct Snapshot
+		{
+			uint32_t sequence = 0;
+			LocalVector<int64_t> values;
+		};
+
+		/// @brief The last acknowledged quantized values.
+		LocalVector<int64_t> baseline;
+		/// @brief Sent snapshots still waiting for an ack.
+		LocalVector<Snapshot> pending;
+		/// @brief The next sequence to send.
+		uint32_t next_sequence = 1;
+		/// @brief The last sequence received.
+		uint32_t last_received_sequence = 0;
+		/// @brief Whether a sequence has been received yet.
+		bool has_received = false;
+	};
+} //namespace gga
+
+#endif
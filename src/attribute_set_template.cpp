@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*  attribute_set_template.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "attribute_set_template.hpp"
+
+#include "attribute.hpp"
+
+using namespace gga;
+
+void AttributeSetTemplate::_bind_methods()
+{
+	/// binds methods to godot
+	ClassDB::bind_method(D_METHOD("find", "p_name"), &AttributeSetTemplate::find);
+	ClassDB::bind_method(D_METHOD("get_attribute_count"), &AttributeSetTemplate::get_attribute_count);
+	ClassDB::bind_method(D_METHOD("get_attributes_names"), &AttributeSetTemplate::get_attributes_names);
+	ClassDB::bind_method(D_METHOD("get_initial_value", "p_index"), &AttributeSetTemplate::get_initial_value);
+	ClassDB::bind_method(D_METHOD("get_max_value", "p_index"), &AttributeSetTemplate::get_max_value);
+	ClassDB::bind_method(D_METHOD("get_min_value", "p_index"), &AttributeSetTemplate::get_min_value);
+}
+
+Ref<AttributeSetTemplate> AttributeSetTemplate::bake(const Ref<AttributeSet> &p_attribute_set)
+{
+	Ref<AttributeSetTemplate> baked = memnew(AttributeSetTemplate);
+
+	ERR_FAIL_COND_V_MSG(p_attribute_set.is_null(), baked, "Cannot bake a null attribute set.");
+
+	baked->entries.resize(p_attribute_set->count());
+
+	for (int i = 0; i < p_attribute_set->count(); i++) {
+		Ref<AttributeBase> attribute = p_attribute_set->get_at(i);
+		Entry &entry = baked->entries[i];
+
+		ERR_CONTINUE_MSG(attribute.is_null(), "Attribute set contains a null attribute.");
+
+		/// a detached runtime attribute evaluates the script virtuals exactly as a container would
+		Ref<RuntimeAttribute> runtime_attribute = memnew(RuntimeAttribute);
+		runtime_attribute->set_attribute(attribute);
+		runtime_attribute->set_attribute_set(p_attribute_set);
+		runtime_attribute->set_value(runtime_attribute->get_initial_value());
+
+		entry.attribute = attribute;
+		entry.attribute_name = attribute->get_attribute_name();
+		entry.initial_value = runtime_attribute->get_value();
+		entry.min_value = runtime_attribute->get_min_value();
+		entry.max_value = runtime_attribute->get_max_value();
+		entry.derived_from = runtime_attribute->get_derived_from();
+
+		entry.buffs = attribute->get_buffs().duplicate();
+		entry.buffs.make_read_only();
+		entry.derived_from.make_read_only();
+	}
+
+	return baked;
+}
+
+TypedArray<RuntimeBuff> AttributeSetTemplate::Entry::instantiate_buffs() const
+{
+	TypedArray<RuntimeBuff> runtime_buffs;
+
+	for (int i = 0; i < buffs.size(); i++) {
+		runtime_buffs.push_back(RuntimeBuff::from_buff(buffs[i]));
+	}
+
+	return runtime_buffs;
+}
+
+const LocalVector<AttributeSetTemplate::Entry> &AttributeSetTemplate::get_entries() const
+{
+	return entries;
+}
+
+int AttributeSetTemplate::get_attribute_count() const
+{
+	return entries.size();
+}
+
+PackedStringArray AttributeSetTemplate::get_attributes_names() const
+{
+	PackedStringArray names = PackedStringArray();
+
+	for (uint32_t i = 0; i < entries.size(); i++) {
+		names.push_back(entries[i].attribute_name);
+	}
+
+	return names;
+}
+
+int AttributeSetTemplate::find(const String &p_name) const
+{
+	for (uint32_t i = 0; i < entries.size(); i++) {
+		if (entries[i].attribute_name == p_name) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+float AttributeSetTemplate::get_initial_value(const int p_index) const
+{
+	ERR_FAIL_INDEX_V(p_index, (int)entries.size(), 0.0f);
+	return entries[p_index].initial_value;
+}
+
+float AttributeSetTemplate::get_max_value(const int p_index) const
+{
+	ERR_FAIL_INDEX_V(p_index, (int)entries.size(), 0.0f);
+	return entries[p_index].max_value;
+}
+
+float AttributeSetTemplate::get_min_value(const int p_index) const
+{
+	ERR_FAIL_INDEX_V(p_index, (int)entries.size(), 0.0f);
+	return entries[p_index].min_value;
+}
@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  attribute_set_template.hpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GGA_ATTRIBUTE_SET_TEMPLATE_HPP
+#define GGA_ATTRIBUTE_SET_TEMPLATE_HPP
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+using namespace godot;
+
+namespace gga
+{
+	class AttributeBase;
+	class AttributeBuff;
+	class AttributeSet;
+	class RuntimeBuff;
+
+	/// @brief Immutable snapshot of an AttributeSet, baked once and shared by every AttributeContainer using the set.
+	class AttributeSetTemplate : public RefCounted
+	{
+		GDCLASS(AttributeSetTemplate, RefCounted);
+
+	public:
+		/// @brief The baked data of a single attribute.
+		struct Entry
+		{
+			/// @brief The attribute resource.
+			Ref<AttributeBase> attribute;
+			/// @brief The attribute name.
+			String attribute_name;
+			/// @brief The initial value, already clamped.
+			float initial_value = 0.0f;
+			/// @brief The minimum value.
+			float min_value = 0.0f;
+			/// @brief The maximum value.
+			float max_value = 0.0f;
+			/// @brief The default buffs. Runtime buffs hold per container state, each container instantiates its own.
+			TypedArray<AttributeBuff> buffs;
+			/// @brief The attributes this attribute derives from.
+			TypedArray<AttributeBase> derived_from;
+
+			/// @brief Creates the runtime buffs of a new instance from the default buffs.
+			/// @return The runtime buffs.
+			TypedArray<RuntimeBuff> instantiate_buffs() const;
+		};
+
+	protected:
+		/// @brief Bind methods to Godot.
+		static void _bind_methods();
+		/// @brief The baked attributes, in the same order of the set.
+		LocalVector<Entry> entries;
+
+	public:
+		/// @brief Bakes an attribute set into a template. Every script virtual needed to spawn the attributes is called here, once.
+		/// @param p_attribute_set The attribute set to bake.
+		/// @return The baked template.
+		static Ref<AttributeSetTemplate> bake(const Ref<AttributeSet> &p_attribute_set);
+
+		/// @brief Returns the baked entries.
+		/// @return The baked entries.
+		const LocalVector<Entry> &get_entries() const;
+		/// @brief Returns the number of baked attributes.
+		/// @return The number of baked attributes.
+		int get_attribute_count() const;
+		/// @brief Returns the baked attribute names.
+		/// @return The baked attribute names.
+		PackedStringArray get_attributes_names() const;
+		/// @brief Returns the index of an attribute by name.
+		/// @param p_name The attribute name.
+		/// @return The index of the attribute, -1 if not found.
+		int find(const String &p_name) const;
+		/// @brief Returns the baked initial value of an attribute.
+		/// @param p_index The attribute index.
+		/// @return The initial value.
+		float get_initial_value(const int p_index) const;
+		/// @brief Returns the baked maximum value of an attribute.
+		/// @param p_index The attribute index.
+		/// @return The maximum value.
+		float get_max_value(const int p_index) const;
+		/// @brief Returns the baked minimum value of an attribute.
+		/// @param p_index The attribute index.
+		/// @return The minimum value.
+		float get_min_value(const int p_index) const;
+	};
+} //namespace gga
+
+#endif
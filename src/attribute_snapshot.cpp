@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  attribute_snapshot.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "attribute_snapshot.hpp"
+
+#include <godot_cpp/core/defs.hpp>
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/core/memory.hpp>
+
+using namespace gga;
+
+AttributeSnapshot::~AttributeSnapshot()
+{
+	Storage *current = storage.load(std::memory_order_relaxed);
+
+	while (current != nullptr) {
+		Storage *retired = current->retired;
+		memdelete_arr(current->data);
+		memdelete(current);
+		current = retired;
+	}
+}
+
+void AttributeSnapshot::write_bank(Storage *p_storage, const uint32_t p_bank, const LocalVector<float> &p_values, const LocalVector<float> &p_buffed_values)
+{
+	std::atomic<float> *bank = p_storage->data + (uint64_t)p_bank * p_storage->capacity * 2;
+
+	for (uint32_t i = 0; i < p_values.size(); i++) {
+		bank[i * 2].store(p_values[i], std::memory_order_relaxed);
+		bank[i * 2 + 1].store(p_buffed_values[i], std::memory_order_relaxed);
+	}
+
+	p_storage->size[p_bank].store(p_values.size(), std::memory_order_relaxed);
+}
+
+void AttributeSnapshot::publish(const LocalVector<float> &p_values, const LocalVector<float> &p_buffed_values)
+{
+	ERR_FAIL_COND_MSG(p_values.size() != p_buffed_values.size(), "Values and buffed values must have the same size.");
+
+	Storage *current = storage.load(std::memory_order_relaxed);
+	uint32_t begin = sequence.load(std::memory_order_relaxed);
+	uint32_t back = ((begin >> 1) + 1) & 1;
+
+	/// the odd sequence is ordered before every data store, a reader seeing any of them sees the write in progress
+	sequence.store(begin + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	if (current == nullptr || current->capacity < p_values.size()) {
+		Storage *grown = memnew(Storage);
+
+		grown->capacity = MAX(p_values.size(), current != nullptr ? current->capacity * 2 : 8u);
+		grown->data = memnew_arr(std::atomic<float>, (uint64_t)grown->capacity * 4);
+		grown->retired = current;
+
+		/// readers may still read the front bank of the new storage before the sequence moves, both banks are filled
+		write_bank(grown, 0, p_values, p_buffed_values);
+		write_bank(grown, 1, p_values, p_buffed_values);
+		storage.store(grown, std::memory_order_release);
+	} else {
+		write_bank(current, back, p_values, p_buffed_values);
+	}
+
+	/// the data stores are ordered before the even sequence, a reader seeing it sees the whole bank
+	std::atomic_thread_fence(std::memory_order_release);
+	sequence.store(begin + 2, std::memory_order_relaxed);
+}
+
+bool AttributeSnapshot::read(const uint32_t p_index, float &r_value, float &r_buffed_value) const
+{
+	while (true) {
+		uint32_t begin = sequence.load(std::memory_order_acquire);
+		const Storage *current = storage.load(std::memory_order_acquire);
+
+		if (current == nullptr) {
+			return false;
+		}
+
+		/// while the sequence is odd the back bank is being written, the front bank is still the previous one
+		uint32_t front = (begin >> 1) & 1;
+		const std::atomic<float> *bank = current->data + (uint64_t)front * current->capacity * 2;
+		uint32_t size = current->size[front].load(std::memory_order_relaxed);
+		bool in_bounds = p_index < size;
+
+		if (in_bounds) {
+			r_value = bank[p_index * 2].load(std::memory_order_relaxed);
+			r_buffed_value = bank[p_index * 2 + 1].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		/// the front bank is written again only by the second publish after it, which makes the sequence reach begin + 3
+		if (sequence.load(std::memory_order_relaxed) - (begin & ~1u) <= 2) {
+			return in_bounds;
+		}
+	}
+}
+
+uint32_t AttributeSnapshot::get_size() const
+{
+	while (true) {
+		uint32_t begin = sequence.load(std::memory_order_acquire);
+		const Storage *current = storage.load(std::memory_order_acquire);
+
+		if (current == nullptr) {
+			return 0;
+		}
+
+		uint32_t size = current->size[(begin >> 1) & 1].load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (sequence.load(std::memory_order_relaxed) - (begin & ~1u) <= 2) {
+			return size;
+		}
+	}
+}
@@ -0,0 +1,93 @@
+/**************************************************************************/
+/*  attribute_snapshot.hpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GGA_ATTRIBUTE_SNAPSHOT_HPP
+#define GGA_ATTRIBUTE_SNAPSHOT_HPP
+
+#include <godot_cpp/templates/local_vector.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+using namespace godot;
+
+namespace gga
+{
+	/// @brief Double buffered copy of the values of an AttributeContainer, readable from any thread.
+	///
+	/// The sequence is a seqlock counter: it is odd while the owner thread writes the back bank, and even again once the
+	/// bank becomes the front bank. Readers read the front bank and retry only if the writer started writing that bank
+	/// again in the meanwhile, which takes two publishes, so they never block the writer.
+	/// Storage only grows, replaced storage is kept alive until the snapshot is destroyed so that a reader
+	/// holding the previous storage never reads freed memory.
+	class AttributeSnapshot
+	{
+	public:
+		AttributeSnapshot() = default;
+		~AttributeSnapshot();
+
+		AttributeSnapshot(const AttributeSnapshot &) = delete;
+		AttributeSnapshot &operator=(const AttributeSnapshot &) = delete;
+
+		/// @brief Publishes new values. Must be called from the owner thread only.
+		/// @param p_values The values.
+		/// @param p_buffed_values The buffed values, must have the same size of the values.
+		void publish(const LocalVector<float> &p_values, const LocalVector<float> &p_buffed_values);
+		/// @brief Reads a published value. Safe to call from any thread.
+		/// @param p_index The index of the value.
+		/// @param r_value The value.
+		/// @param r_buffed_value The buffed value.
+		/// @return False if the index is out of bounds.
+		bool read(const uint32_t p_index, float &r_value, float &r_buffed_value) const;
+		/// @brief Returns the number of published values. Safe to call from any thread.
+		/// @return The number of published values.
+		uint32_t get_size() const;
+
+	protected:
+		/// @brief Storage of both banks, each entry is a value followed by its buffed value.
+		struct Storage
+		{
+			uint32_t capacity = 0;
+			/// @brief The number of values of each bank.
+			std::atomic<uint32_t> size[2];
+			std::atomic<float> *data = nullptr;
+			Storage *retired = nullptr;
+		};
+
+		/// @brief The current storage.
+		std::atomic<Storage *> storage{ nullptr };
+		/// @brief The seqlock counter, odd while a bank is written. Its second bit is the front bank.
+		std::atomic<uint32_t> sequence{ 0 };
+
+		/// @brief Writes a bank of the given storage.
+		static void write_bank(Storage *p_storage, const uint32_t p_bank, const LocalVector<float> &p_values, const LocalVector<float> &p_buffed_values);
+	};
+} //namespace gga
+
+#endif
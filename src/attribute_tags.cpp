@@ -0,0 +1,108 @@
+/**************************************************************************/
+/*  attribute_tags.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "attribute_tags.hpp"
+
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+
+#include <mutex>
+
+using namespace gga;
+
+namespace
+{
+	typedef HashMap<StringName, int32_t> TagRegistry;
+
+	/// @brief The registered tags and their bit.
+	TagRegistry *registry = nullptr;
+	/// @brief Resources can be loaded from other threads, registration is serialized.
+	std::mutex registry_mutex;
+} //namespace
+
+void AttributeTags::initialize()
+{
+	if (registry == nullptr) {
+		registry = memnew(TagRegistry);
+	}
+}
+
+void AttributeTags::finalize()
+{
+	if (registry != nullptr) {
+		memdelete(registry);
+		registry = nullptr;
+	}
+}
+
+int32_t AttributeTags::find(const StringName &p_tag)
+{
+	std::lock_guard<std::mutex> lock(registry_mutex);
+
+	ERR_FAIL_NULL_V_MSG(registry, -1, "Attribute tags registry is not initialized.");
+
+	const int32_t *bit = registry->getptr(p_tag);
+	return bit != nullptr ? *bit : -1;
+}
+
+int32_t AttributeTags::intern(const StringName &p_tag)
+{
+	std::lock_guard<std::mutex> lock(registry_mutex);
+
+	ERR_FAIL_NULL_V_MSG(registry, -1, "Attribute tags registry is not initialized.");
+
+	const int32_t *bit = registry->getptr(p_tag);
+
+	if (bit != nullptr) {
+		return *bit;
+	}
+
+	ERR_FAIL_COND_V_MSG(registry->size() >= MAX_TAGS, -1, "Too many attribute tags, at most 64 distinct tags are supported.");
+
+	int32_t new_bit = (int32_t)registry->size();
+	registry->insert(p_tag, new_bit);
+
+	return new_bit;
+}
+
+uint64_t AttributeTags::make_mask(const PackedStringArray &p_tags)
+{
+	uint64_t mask = 0;
+
+	for (int64_t i = 0; i < p_tags.size(); i++) {
+		int32_t bit = intern(p_tags[i]);
+
+		if (bit >= 0) {
+			mask |= (uint64_t)1 << bit;
+		}
+	}
+
+	return mask;
+}
@@ -0,0 +1,71 @@
+/**************************************************************************/
+/*  attribute_tags.hpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GGA_ATTRIBUTE_TAGS_HPP
+#define GGA_ATTRIBUTE_TAGS_HPP
+
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/string_name.hpp>
+
+#include <cstdint>
+
+using namespace godot;
+
+namespace gga
+{
+	/// @brief Registry interning gameplay tags into bits.
+	///
+	/// Each distinct tag gets a bit the first time it is seen, so a set of tags is a single 64 bit mask
+	/// and category checks are a bitwise and. The registry lives from the extension initialization to its termination.
+	class AttributeTags
+	{
+	public:
+		/// @brief The maximum number of distinct tags.
+		static constexpr uint32_t MAX_TAGS = 64;
+
+		/// @brief Allocates the registry, called when the extension is initialized.
+		static void initialize();
+		/// @brief Frees the registry, called when the extension is terminated.
+		static void finalize();
+		/// @brief Returns the bit of a registered tag.
+		/// @param p_tag The tag.
+		/// @return The bit index of the tag, or -1 if the tag was never registered.
+		static int32_t find(const StringName &p_tag);
+		/// @brief Returns the bit of a tag, registering it if needed.
+		/// @param p_tag The tag.
+		/// @return The bit index of the tag, or -1 if the registry is full.
+		static int32_t intern(const StringName &p_tag);
+		/// @brief Returns the mask of a set of tags, registering the unknown ones.
+		/// @param p_tags The tags.
+		/// @return The tags mask.
+		static uint64_t make_mask(const PackedStringArray &p_tags);
+	};
+} //namespace gga
+
+#endif
@@ -0,0 +1,221 @@
+/**************************************************************************/
+/*  attribute_tracer.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "attribute_tracer.hpp"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+using namespace gga;
+
+namespace
+{
+	/// @brief A recorded event.
+	struct TraceEvent
+	{
+		const char *category = nullptr;
+		const char *name = nullptr;
+		String detail;
+		uint64_t start = 0;
+		uint64_t duration = 0;
+		uint64_t thread = 0;
+	};
+
+	/// @brief The ring buffer of the recorded events.
+	struct TraceBuffer
+	{
+		LocalVector<TraceEvent> events;
+		uint32_t next = 0;
+		bool wrapped = false;
+	};
+
+	TraceBuffer *buffer = nullptr;
+	std::mutex buffer_mutex;
+
+	/// @brief Returns the current time in microseconds.
+	uint64_t now_usec()
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+} //namespace
+
+std::atomic<bool> AttributeTracer::enabled{ false };
+
+void AttributeTracer::_bind_methods()
+{
+	ClassDB::bind_static_method("AttributeTracer", D_METHOD("clear"), &AttributeTracer::clear);
+	ClassDB::bind_static_method("AttributeTracer", D_METHOD("dump", "p_path"), &AttributeTracer::dump);
+	ClassDB::bind_static_method("AttributeTracer", D_METHOD("get_event_count"), &AttributeTracer::get_event_count);
+	ClassDB::bind_static_method("AttributeTracer", D_METHOD("is_enabled"), &AttributeTracer::is_enabled);
+	ClassDB::bind_static_method("AttributeTracer", D_METHOD("start", "p_capacity"), &AttributeTracer::start, DEFVAL(DEFAULT_CAPACITY));
+	ClassDB::bind_static_method("AttributeTracer", D_METHOD("stop"), &AttributeTracer::stop);
+}
+
+void AttributeTracer::Scope::begin()
+{
+	start = now_usec();
+	active = true;
+}
+
+AttributeTracer::Scope::~Scope()
+{
+	if (!active) {
+		return;
+	}
+
+	String *scope_detail = reinterpret_cast<String *>(detail);
+
+	/// the scope is not recorded if the tracer was stopped meanwhile
+	if (enabled.load(std::memory_order_relaxed)) {
+		uint64_t end = now_usec();
+		std::lock_guard<std::mutex> lock(buffer_mutex);
+
+		if (buffer != nullptr && buffer->events.size() > 0) {
+			TraceEvent &event = buffer->events[buffer->next];
+
+			event.category = category;
+			event.name = name;
+			event.detail = *scope_detail;
+			event.start = start;
+			event.duration = end - start;
+			event.thread = (uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+
+			buffer->next++;
+
+			if (buffer->next == buffer->events.size()) {
+				buffer->next = 0;
+				buffer->wrapped = true;
+			}
+		}
+	}
+
+	scope_detail->~String();
+}
+
+bool AttributeTracer::is_enabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void AttributeTracer::start(const int p_capacity)
+{
+	ERR_FAIL_COND_MSG(p_capacity <= 0, "Tracer capacity must be greater than zero.");
+
+	std::lock_guard<std::mutex> lock(buffer_mutex);
+
+	if (buffer == nullptr) {
+		buffer = memnew(TraceBuffer);
+	}
+
+	buffer->events.clear();
+	buffer->events.resize(p_capacity);
+	buffer->next = 0;
+	buffer->wrapped = false;
+
+	enabled.store(true, std::memory_order_relaxed);
+}
+
+void AttributeTracer::stop()
+{
+	enabled.store(false, std::memory_order_relaxed);
+}
+
+void AttributeTracer::clear()
+{
+	std::lock_guard<std::mutex> lock(buffer_mutex);
+
+	if (buffer != nullptr) {
+		buffer->next = 0;
+		buffer->wrapped = false;
+	}
+}
+
+int AttributeTracer::get_event_count()
+{
+	std::lock_guard<std::mutex> lock(buffer_mutex);
+
+	if (buffer == nullptr) {
+		return 0;
+	}
+
+	return buffer->wrapped ? (int)buffer->events.size() : (int)buffer->next;
+}
+
+Error AttributeTracer::dump(const String &p_path)
+{
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(file.is_null(), FileAccess::get_open_error(), "Cannot open the trace file for writing.");
+
+	std::lock_guard<std::mutex> lock(buffer_mutex);
+
+	file->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+	if (buffer != nullptr) {
+		uint32_t count = buffer->wrapped ? buffer->events.size() : buffer->next;
+		uint32_t first = buffer->wrapped ? buffer->next : 0;
+
+		/// events are written oldest first
+		for (uint32_t i = 0; i < count; i++) {
+			const TraceEvent &event = buffer->events[(first + i) % buffer->events.size()];
+			String line = i > 0 ? ",\n" : "\n";
+
+			line += "{\"name\":\"" + String(event.name) + "\",\"cat\":\"" + String(event.category) + "\",\"ph\":\"X\"";
+			line += ",\"ts\":" + String::num_uint64(event.start) + ",\"dur\":" + String::num_uint64(event.duration);
+			line += ",\"pid\":1,\"tid\":" + String::num_uint64(event.thread % 1000000);
+
+			if (!event.detail.is_empty()) {
+				line += ",\"args\":{\"detail\":\"" + event.detail.json_escape() + "\"}";
+			}
+
+			file->store_string(line + "}");
+		}
+	}
+
+	file->store_string("\n]}\n");
+
+	return OK;
+}
+
+void AttributeTracer::finalize()
+{
+	enabled.store(false, std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex> lock(buffer_mutex);
+
+	if (buffer != nullptr) {
+		memdelete(buffer);
+		buffer = nullptr;
+	}
+}
@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*  attribute_tracer.hpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Copyright (c) 2020-present Paolo "OctoD"      Roth (see AUTHORS.md).   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GGA_ATTRIBUTE_TRACER_HPP
+#define GGA_ATTRIBUTE_TRACER_HPP
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/class_db.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+using namespace godot;
+
+/// @brief Traces the enclosing scope when the tracer is enabled. The detail expression is only evaluated while tracing,
+/// a disabled scope constructs no String.
+#define GGA_TRACE_SCOPE(m_category, m_name, m_detail) \
+	gga::AttributeTracer::Scope _gga_trace_scope(m_category, m_name, [&]() { return String(m_detail); })
+
+namespace gga
+{
+	/// @brief Opt-in tracer of the attribute system activity.
+	///
+	/// Scoped events are recorded into a fixed size ring buffer, the oldest events are overwritten when it is full.
+	/// While the tracer is disabled a scope only costs an atomic load. The buffer can be dumped as a Chrome trace event
+	/// JSON file, which can be opened with chrome://tracing or https://ui.perfetto.dev.
+	class AttributeTracer : public Object
+	{
+		GDCLASS(AttributeTracer, Object);
+
+	protected:
+		/// @brief Bind methods to Godot.
+		static void _bind_methods();
+
+	public:
+		/// @brief A traced scope, recorded when it ends.
+		class Scope
+		{
+			const char *category;
+			const char *name;
+			uint64_t start = 0;
+			/// @brief Whether the scope started while the tracer was enabled.
+			bool active = false;
+			/// @brief Storage of the detail, only constructed while tracing.
+			alignas(String) uint8_t detail[sizeof(String)];
+
+			/// @brief Starts timing the scope.
+			void begin();
+
+		public:
+			/// @brief Starts the scope if the tracer is enabled.
+			/// @param p_category The category of the event.
+			/// @param p_name The name of the event.
+			/// @param p_detail A callable returning the detail, only called if the tracer is enabled.
+			template <typename T>
+			Scope(const char *p_category, const char *p_name, const T &p_detail) :
+					category(p_category), name(p_name)
+			{
+				if (is_enabled()) {
+					new (detail) String(p_detail());
+					begin();
+				}
+			}
+			~Scope();
+		};
+
+		/// @brief The default capacity of the ring buffer.
+		static constexpr int DEFAULT_CAPACITY = 65536;
+
+		/// @brief Returns if the tracer is recording.
+		/// @return True if the tracer is recording.
+		static bool is_enabled();
+		/// @brief Starts recording, discarding the previous events.
+		/// @param p_capacity The number of events kept in the ring buffer.
+		static void start(const int p_capacity = DEFAULT_CAPACITY);
+		/// @brief Stops recording, the recorded events are kept until the next start.
+		static void stop();
+		/// @brief Discards the recorded events.
+		static void clear();
+		/// @brief Returns the number of recorded events.
+		/// @return The number of events in the ring buffer.
+		static int get_event_count();
+		/// @brief Writes the recorded events to a Chrome trace event JSON file.
+		/// @param p_path The file path.
+		/// @return OK, or the error of the file opening.
+		static Error dump(const String &p_path);
+		/// @brief Frees the ring buffer, called when the extension is terminated.
+		static void finalize();
+
+	private:
+		/// @brief Whether the tracer is recording.
+		static std::atomic<bool> enabled;
+	};
+} //namespace gga
+
+#endif
@@ -29,6 +29,7 @@
 
 #include "buff_pool_queue.hpp"
 #include "attribute.hpp"
+#include "attribute_tracer.hpp"
 
 using namespace gga;
 
@@ -44,27 +45,43 @@ void BuffPoolQueue::_exit_tree()
 	clear();
 }
 
-void BuffPoolQueue::handle_physics_process(double p_delta)
+void BuffPoolQueue::advance(double p_delta)
 {
-	tick += p_delta;
-
-	if (Math::is_equal_approx(tick, 1.0)) {
-		double discarded = tick - 1.0;
-		tick = discarded;
-		process_items(discarded);
+	if (!queue.is_empty()) {
+		tick += p_delta;
 	}
 }
 
+void BuffPoolQueue::handle_physics_process(double p_delta)
+{
+	advance(p_delta);
+	process_due();
+}
+
 void BuffPoolQueue::enqueue(Ref<RuntimeBuff> p_buff)
 {
 	if (server_authoritative && !is_multiplayer_authority()) {
 		return;
 	}
 
+	/// brings the queued buffs up to date, so every time left is relative to now
+	if (!queue.is_empty() && tick > 0.0) {
+		process_items(tick);
+	}
+
+	if (queue.is_empty() || p_buff->get_time_left() < next_deadline) {
+		next_deadline = p_buff->get_time_left();
+	}
+
 	queue.push_back(p_buff);
 	emit_signal("attribute_buff_enqueued", p_buff);
 }
 
+double BuffPoolQueue::get_elapsed() const
+{
+	return tick;
+}
+
 bool BuffPoolQueue::get_server_authoritative() const
 {
 	return server_authoritative;
@@ -73,25 +90,54 @@ bool BuffPoolQueue::get_server_authoritative() const
 void BuffPoolQueue::clear()
 {
 	queue.clear();
+	tick = 0.0;
+	next_deadline = 0.0;
+}
+
+bool BuffPoolQueue::is_empty() const
+{
+	return queue.is_empty();
+}
+
+void BuffPoolQueue::process_due()
+{
+	/// nothing can expire before the first deadline, the buffs are not visited until then
+	if (!queue.is_empty() && tick >= next_deadline) {
+		process_items(tick);
+	}
 }
 
-void BuffPoolQueue::process_items(const double discarded)
+void BuffPoolQueue::process_items(const double p_elapsed)
 {
 	if (server_authoritative && !is_multiplayer_authority()) {
 		return;
 	}
 
-	float discarded_float = discarded + 1.0f;
+	GGA_TRACE_SCOPE("queue", "process_items", String::num_int64(queue.size()));
+
+	tick = 0.0;
+	next_deadline = 0.0;
+
+	bool has_deadline = false;
+	TypedArray<RuntimeBuff> expired;
 
 	for (int i = queue.size() - 1; i >= 0; i--) {
 		Ref<RuntimeBuff> buff = queue[i];
-		buff->set_time_left(buff->get_time_left() - discarded_float);
+		buff->set_time_left(buff->get_time_left() - p_elapsed);
 
 		if (buff->can_dequeue()) {
 			queue.remove_at(i);
-			emit_signal("attribute_buff_dequeued", buff);
+			expired.push_back(buff);
+		} else if (!has_deadline || buff->get_time_left() < next_deadline) {
+			next_deadline = buff->get_time_left();
+			has_deadline = true;
 		}
 	}
+
+	/// listeners may enqueue buffs again, the deadline is final before any of them runs
+	for (int i = 0; i < expired.size(); i++) {
+		emit_signal("attribute_buff_dequeued", expired[i]);
+	}
 }
 
 void BuffPoolQueue::set_server_authoritative(const bool p_server_authoritative)
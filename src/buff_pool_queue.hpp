@@ -46,27 +46,42 @@ namespace gga
 	protected:
 		/// @brief Binds methods to Godot.
 		static void _bind_methods();
-		/// @brief The current tick.
-		double tick;
+		/// @brief The time elapsed since the queue was last processed.
+		double tick = 0.0;
+		/// @brief The time left of the buff expiring first, relative to the last processing.
+		double next_deadline = 0.0;
 		/// @brief The queue of buffs.
 		TypedArray<RuntimeBuff> queue;
 		/// @brief Whether the queue is server authoritative.
-		bool server_authoritative;
+		bool server_authoritative = false;
 
 	public:
 		/// @brief Overridden _exit_tree method.
 		void _exit_tree() override;
-		/// @brief Overridden _physics_process method.
+		/// @brief Advances the time of the queue without visiting the buffs.
+		/// @param p_delta The delta time.
+		void advance(double p_delta);
+		/// @brief Advances the queue, buffs are only visited when the first deadline is reached.
+		/// @param p_delta The delta time.
 		void handle_physics_process(double p_delta);
 		/// @brief Adds a buff to the queue.
 		void enqueue(Ref<RuntimeBuff> p_buff);
+		/// @brief Returns the time elapsed since the queue was last processed, the time left of the queued buffs is relative to it.
+		/// @return The elapsed time.
+		double get_elapsed() const;
 		/// @brief Returns if the queue is server authoritative.
 		/// @return Whether the queue is server authoritative.
 		bool get_server_authoritative() const;
 		/// @brief Clears the queue.
 		void clear();
-		/// @brief Processes the items in the queue.
-		void process_items(const double p_discarded);
+		/// @brief Returns if the queue has no buff waiting to expire.
+		/// @return True if the queue is empty.
+		bool is_empty() const;
+		/// @brief Dequeues the expired buffs if the first deadline is reached.
+		void process_due();
+		/// @brief Processes the items in the queue, dequeuing the expired ones.
+		/// @param p_elapsed The time elapsed since the last processing.
+		void process_items(const double p_elapsed);
 		/// @brief Sets the server authoritative flag.
 		/// @param p_server_authoritative The server authoritative flag.
 		void set_server_authoritative(const bool p_server_authoritative);
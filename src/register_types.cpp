@@ -29,26 +29,51 @@
 
 #include "attribute.hpp"
 #include "attribute_container.hpp"
+#include "attribute_library.hpp"
+#include "attribute_recorder.hpp"
+#include "attribute_set_template.hpp"
+#include "attribute_tags.hpp"
+#include "attribute_tracer.hpp"
 #include "buff_pool_queue.hpp"
+#include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/resource_saver.hpp>
 #include <godot_cpp/core/class_db.hpp>
 
 using namespace godot;
 
+static Ref<gga::AttributeLibraryLoader> attribute_library_loader;
+static Ref<gga::AttributeLibrarySaver> attribute_library_saver;
+
 void gdextension_initialize(ModuleInitializationLevel p_level)
 {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
+		/// tags are interned while resources load, the registry must exist before any of them
+		gga::AttributeTags::initialize();
 		/// attributes, resources and operations
 		ClassDB::register_class<gga::AttributeOperation>();
 		ClassDB::register_class<gga::AttributeBuff>();
 		ClassDB::register_abstract_class<gga::AttributeBase>();
 		ClassDB::register_class<gga::Attribute>();
 		ClassDB::register_class<gga::AttributeSet>();
+		ClassDB::register_class<gga::AttributeLibrary>();
 		/// nodes
 		ClassDB::register_runtime_class<gga::AttributeContainer>();
 		ClassDB::register_runtime_class<gga::BuffPoolQueue>();
 		/// runtime classes
 		ClassDB::register_runtime_class<gga::RuntimeBuff>();
 		ClassDB::register_runtime_class<gga::RuntimeAttribute>();
+		ClassDB::register_runtime_class<gga::AttributeSetTemplate>();
+		/// resource formats
+		ClassDB::register_class<gga::AttributeLibraryLoader>();
+		ClassDB::register_class<gga::AttributeLibrarySaver>();
+		attribute_library_loader.instantiate();
+		attribute_library_saver.instantiate();
+		ResourceLoader::get_singleton()->add_resource_format_loader(attribute_library_loader);
+		ResourceSaver::get_singleton()->add_resource_format_saver(attribute_library_saver);
+		/// diagnostics
+		ClassDB::register_class<gga::AttributeTracer>();
+		ClassDB::register_class<gga::AttributeRecorder>();
+		ClassDB::register_class<gga::AttributeReplayer>();
 	} else if (p_level == MODULE_INITIALIZATION_LEVEL_EDITOR) {
 	}
 }
@@ -56,7 +81,14 @@ void gdextension_initialize(ModuleInitializationLevel p_level)
 void gdextension_terminate(ModuleInitializationLevel p_level)
 {
 	/// I love lasagna
-	if (p_level == MODULE_INITIALIZATION_LEVEL_EDITOR) {
+	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
+		ResourceLoader::get_singleton()->remove_resource_format_loader(attribute_library_loader);
+		ResourceSaver::get_singleton()->remove_resource_format_saver(attribute_library_saver);
+		attribute_library_loader.unref();
+		attribute_library_saver.unref();
+		gga::AttributeTracer::finalize();
+		gga::AttributeTags::finalize();
+	} else if (p_level == MODULE_INITIALIZATION_LEVEL_EDITOR) {
 	}
 }
 